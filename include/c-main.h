@@ -153,6 +153,8 @@ void MLton_threadFunc (void* arg) {                                     \
     /* Set up tracing infrastructure */                                 \
     for (procNo = 0; procNo < gcState[0].numberOfProcs; procNo++)       \
         GC_traceInit(&gcState[procNo]);                                 \
+    /* Start the metrics endpoint, if requested */                      \
+    GC_metricsInit(&gcState[0]);                                        \
     /* Now create the threads */                                        \
     for (procNo = 1; procNo < gcState[0].numberOfProcs; procNo++) {     \
       if (pthread_create (&gcState[procNo].self, NULL, &MLton_threadFunc, (void *)&gcState[procNo])) { \
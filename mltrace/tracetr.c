@@ -83,14 +83,30 @@ static const char *EventKindStrings[] = {
 
   [EVENT_SCHED_SLEEP_ENTER] = "SCHED_SLEEP_ENTER",
   [EVENT_SCHED_SLEEP_LEAVE] = "SCHED_SLEEP_LEAVE",
+
+  [EVENT_TRACE_DROPPED]         = "TRACE_DROPPED",
+};
+
+/* Sequential decoder for one trace file, in either format. */
+struct TraceReader {
+  FILE *file;
+  bool compact;
+  EventInt procNumber;
+  EventInt time;
 };
 
+void openTraceReader(struct TraceReader *reader, FILE *file);
+bool readEvent(struct TraceReader *reader, struct Event *event);
+
 void processFiles(size_t filecount, FILE **files, void (*func)(struct Event *));
 void processFilesChromeTracingJSON(size_t filecount, FILE **files);
 
 void printEventText(struct Event *);
 void printEventCSV(struct Event *);
 void printEventChromeTracingJSON(struct Event *);
+void writeEventPerfetto(struct Event *);
+void recordEventSummary(struct Event *);
+void printSummary(void);
 
 void usage() {
   fprintf(stderr,
@@ -99,6 +115,8 @@ void usage() {
           "  -d                 display contents in human-readable format\n"
           "  -c                 display contents in CSV format\n"
           "  -j                 display contents in Chrome Tracing JSON format\n"
+          "  -p                 write contents as a Perfetto protobuf trace\n"
+          "  -s                 summarize the durations of each kind of event\n"
           "  -h                 display this message\n"
     );
 }
@@ -107,12 +125,13 @@ int main(int argc, char *argv[]) {
   int opt;
   size_t fcount;
   bool display = false, csv = false, chromeTracingJSON = false;
+  bool perfetto = false, summary = false;
   bool read_stdin = false;
   FILE **files;
 
   /* Parse command line arguments. */
 
-  while ((opt = getopt(argc, argv, "dhcj")) != -1) {
+  while ((opt = getopt(argc, argv, "dhcjps")) != -1) {
     switch (opt) {
     case 'd':
       display = true;
@@ -123,6 +142,12 @@ int main(int argc, char *argv[]) {
     case 'j':
       chromeTracingJSON = true;
       break;
+    case 'p':
+      perfetto = true;
+      break;
+    case 's':
+      summary = true;
+      break;
     case 'h':
       usage();
       return 0;
@@ -170,6 +195,14 @@ int main(int argc, char *argv[]) {
   if (chromeTracingJSON)
     processFilesChromeTracingJSON(fcount, files);
 
+  if (perfetto)
+    processFiles(fcount, files, writeEventPerfetto);
+
+  if (summary) {
+    processFiles(fcount, files, recordEventSummary);
+    printSummary();
+  }
+
   /* Close and free files. */
 
   if (!read_stdin)
@@ -181,53 +214,139 @@ int main(int argc, char *argv[]) {
   return 0;
 }
 
-#define BUFFER_SIZE 10000
+void openTraceReader(struct TraceReader *reader, FILE *file) {
+  int c = getc(file);
+
+  reader->file = file;
+  reader->compact = (c == EVENT_NIL);
+  reader->procNumber = 0;
+  reader->time = 0;
+
+  if (c != EOF)
+    ungetc(c, file);
+}
+
+/* Returns false on end of input, which may be in the middle of a record if
+ * the trace was cut short. */
+static bool readVarint(FILE *file, EventInt *result) {
+  EventInt x = 0;
+  int c;
+
+  for (unsigned int shift = 0; shift < 64; shift += 7) {
+    if ((c = getc(file)) == EOF)
+      return false;
+    x |= (EventInt)(c & 0x7f) << shift;
+    if (!(c & 0x80)) {
+      *result = x;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static bool readCompactEvent(struct TraceReader *reader, struct Event *event) {
+  EventInt kind, delta;
+  EventInt args[3] = {0, 0, 0};
+
+  while (true) {
+    if (!readVarint(reader->file, &kind))
+      return false;
+
+    if (kind != EVENT_NIL)
+      break;
+
+    EventInt version;
+    if (!readVarint(reader->file, &version)
+        || !readVarint(reader->file, &reader->procNumber)) {
+      fprintf(stderr, "warning: truncated trace header\n");
+      return false;
+    }
+
+    if (version != TraceCurrentVersion) {
+      fprintf(stderr, "unsupported trace version %llx\n", version);
+      exit(1);
+    }
+
+    reader->time = 0;
+  }
+
+  unsigned int arity = EventKindArity((int)kind);
+  bool ok = readVarint(reader->file, &delta);
+  for (unsigned int i = 0; ok && i < arity; i++)
+    ok = readVarint(reader->file, &args[i]);
+
+  if (!ok) {
+    fprintf(stderr, "warning: truncated trace record\n");
+    return false;
+  }
+
+  reader->time += delta;
+
+  event->kind = (int)kind;
+  event->argptr = reader->procNumber;
+  event->ts.tv_sec = reader->time / 1000000000ULL;
+  event->ts.tv_nsec = reader->time % 1000000000ULL;
+  event->arg1 = args[0];
+  event->arg2 = args[1];
+  event->arg3 = args[2];
+  return true;
+}
+
+static bool readLegacyEvent(struct TraceReader *reader, struct Event *event) {
+  size_t length = fread(event, 1, sizeof *event, reader->file);
+
+  if (length == 0)
+    return false;
+
+  if (length < sizeof *event) {
+    fprintf(stderr, "warning: truncated trace record\n");
+    return false;
+  }
+
+  return true;
+}
+
+bool readEvent(struct TraceReader *reader, struct Event *event) {
+  if (reader->compact)
+    return readCompactEvent(reader, event);
+  else
+    return readLegacyEvent(reader, event);
+}
 
 void processFiles(size_t filecount, FILE **files,
                   void (*func)(struct Event *)) {
-  struct Event events[BUFFER_SIZE];
+  struct TraceReader reader;
+  struct Event event;
 
   for (size_t i = 0; i < filecount; ++i) {
-    size_t evcount = 0, evbatchsize;
-
-    do {
-      evbatchsize = fread(events, sizeof *events, BUFFER_SIZE,
-                          files[i]);
-      evcount += evbatchsize;
+    openTraceReader(&reader, files[i]);
 
-      for (int j = 0; j < evbatchsize; j++)
-        func(&events[j]);
-
-    } while (evbatchsize == BUFFER_SIZE);
+    while (readEvent(&reader, &event))
+      func(&event);
   }
 }
 
 void processFilesChromeTracingJSON(size_t filecount, FILE **files)
 {
-  struct Event events[BUFFER_SIZE];
+  struct TraceReader reader;
+  struct Event event;
 
   printf("[\n");
 
   bool first = true;
 
   for (size_t i = 0; i < filecount; ++i) {
-    size_t evcount = 0, evbatchsize;
-
-    do {
-      evbatchsize = fread(events, sizeof *events, BUFFER_SIZE,
-                          files[i]);
-      evcount += evbatchsize;
-
-      for (int j = 0; j < evbatchsize; j++) {
+    openTraceReader(&reader, files[i]);
 
-        if (first) first = false;
-        else printf(",\n");
+    while (readEvent(&reader, &event)) {
 
-        printf("  ");
-        printEventChromeTracingJSON(&events[j]);
-      }
+      if (first) first = false;
+      else printf(",\n");
 
-    } while (evbatchsize == BUFFER_SIZE);
+      printf("  ");
+      printEventChromeTracingJSON(&event);
+    }
   }
 
   printf("]\n");
@@ -241,17 +360,23 @@ void printEventKind(int kind) {
   }
 }
 
+/** the name without _ENTER or _LEAVE at end */
+const char *eventKindStripEnterLeave(int kind, char *buf, size_t size) {
+  const char *str = EventKindStrings[kind];
+  size_t len = strlen(str) - 6;
+
+  if (len >= size)
+    len = size - 1;
+  memcpy(buf, str, len);
+  buf[len] = '\0';
+
+  return buf;
+}
+
 /** print the name without _ENTER or _LEAVE at end */
 void printEventKindStripEnterLeave(int kind) {
   char buf[100];
-  buf[99] = '\0';
-
-  const char *str = EventKindStrings[kind];
-  size_t len = strlen(str);
-  strncpy(buf, str, len-6);
-  buf[len-6] = '\0';
-
-  printf("%s", buf);
+  printf("%s", eventKindStripEnterLeave(kind, buf, sizeof buf));
 }
 
 /** chrome tracing documented here:
@@ -436,6 +561,10 @@ void printEventText(struct Event *event) {
            event->arg1, event->arg2, event->arg3);
     break;
 
+  case EVENT_TRACE_DROPPED:
+    printf("events = %lld", event->arg1);
+    break;
+
   default:
     printf("?1 = %llx, ?2 = %llx, ?3 = %llx",
            event->arg1, event->arg2, event->arg3);
@@ -443,3 +572,482 @@ void printEventText(struct Event *event) {
 
   printf(")\n");
 }
+
+/* Per-processor state shared by the Perfetto writer and the summary. */
+struct ProcState {
+  /* Whether the track descriptors of this processor were written. */
+  bool described;
+  uint32_t countersDescribed;
+  /* For each _ENTER kind, 1 + the time at which it was entered, or 0. */
+  EventInt enteredAt[EventKindCount];
+};
+
+static struct ProcState *procStates = NULL;
+static size_t procStatesCount = 0;
+
+struct ProcState *getProcState(uintptr_t proc) {
+  if (proc >= procStatesCount) {
+    size_t count = proc + 1;
+
+    if ((procStates = realloc(procStates, count * sizeof *procStates)) == NULL) {
+      fprintf(stderr, "Could not allocate memory\n");
+      exit(1);
+    }
+    memset(procStates + procStatesCount, 0,
+           (count - procStatesCount) * sizeof *procStates);
+    procStatesCount = count;
+  }
+
+  return &procStates[proc];
+}
+
+EventInt eventTimeNanoseconds(struct Event *event) {
+  return ((EventInt)event->ts.tv_sec) * 1000000000ULL
+         + (EventInt)event->ts.tv_nsec;
+}
+
+/** Perfetto's native trace format is a protobuf `Trace` message, i.e. a
+  * sequence of length-delimited `TracePacket`s (field 1), so packets can be
+  * streamed out one at a time. The schema lives at
+  * https://github.com/google/perfetto/tree/main/protos/perfetto/trace
+  * and only the handful of fields below are used.
+  */
+enum PerfettoField {
+  PF_Trace_packet                       = 1,
+
+  PF_TracePacket_timestamp              = 8,
+  PF_TracePacket_sequenceId             = 10,
+  PF_TracePacket_trackEvent             = 11,
+  PF_TracePacket_trackDescriptor        = 60,
+
+  PF_TrackDescriptor_uuid               = 1,
+  PF_TrackDescriptor_name               = 2,
+  PF_TrackDescriptor_process            = 3,
+  PF_TrackDescriptor_thread             = 4,
+  PF_TrackDescriptor_parentUuid         = 5,
+  PF_TrackDescriptor_counter            = 8,
+
+  PF_ProcessDescriptor_pid              = 1,
+  PF_ProcessDescriptor_processName      = 6,
+
+  PF_ThreadDescriptor_pid               = 1,
+  PF_ThreadDescriptor_tid               = 2,
+  PF_ThreadDescriptor_threadName        = 5,
+
+  PF_TrackEvent_debugAnnotations        = 4,
+  PF_TrackEvent_type                    = 9,
+  PF_TrackEvent_trackUuid               = 11,
+  PF_TrackEvent_categories              = 22,
+  PF_TrackEvent_name                    = 23,
+  PF_TrackEvent_counterValue            = 30,
+
+  PF_DebugAnnotation_uintValue          = 3,
+  PF_DebugAnnotation_name               = 10
+};
+
+enum PerfettoTrackEventType {
+  PT_SliceBegin = 1,
+  PT_SliceEnd   = 2,
+  PT_Instant    = 3,
+  PT_Counter    = 4
+};
+
+/* Counter tracks, one of each per processor, fed by the EVENT_HEAP_OCCUPANCY
+ * that the runtime records at the end of each traced LGC and CGC. */
+enum PerfettoCounter {
+  PC_HeapSize = 1,
+  PC_HeapAllocated
+};
+
+static const char *PerfettoCounterNames[] = {
+  [PC_HeapSize]           = "heap size",
+  [PC_HeapAllocated]      = "heap allocated",
+};
+
+#define PERFETTO_PID 1
+#define PERFETTO_PROCESS_TRACK 1
+#define PERFETTO_PROC_TRACK(proc) (((EventInt)(proc) + 1) << 4)
+#define PERFETTO_COUNTER_TRACK(proc, counter) \
+  (PERFETTO_PROC_TRACK(proc) | (EventInt)(counter))
+
+/* Messages are small (no packet holds more than a few names and integers), so
+ * a fixed-size buffer per message is enough and keeps memory bounded. */
+#define PROTO_MESSAGE_SIZE 512
+
+struct ProtoMessage {
+  size_t length;
+  uint8_t data[PROTO_MESSAGE_SIZE];
+};
+
+static void protoReserve(struct ProtoMessage *msg, size_t bytes) {
+  if (msg->length + bytes > PROTO_MESSAGE_SIZE) {
+    fprintf(stderr, "Perfetto message too large\n");
+    exit(1);
+  }
+}
+
+static void protoRawVarint(struct ProtoMessage *msg, EventInt x) {
+  protoReserve(msg, TraceVarintMaxSize);
+  while (x >= 0x80) {
+    msg->data[msg->length++] = (uint8_t)(x | 0x80);
+    x >>= 7;
+  }
+  msg->data[msg->length++] = (uint8_t)x;
+}
+
+static void protoVarint(struct ProtoMessage *msg, uint32_t field, EventInt x) {
+  protoRawVarint(msg, ((EventInt)field << 3) | 0);
+  protoRawVarint(msg, x);
+}
+
+static void protoBytes(struct ProtoMessage *msg, uint32_t field,
+                       const void *bytes, size_t length) {
+  protoRawVarint(msg, ((EventInt)field << 3) | 2);
+  protoRawVarint(msg, length);
+  protoReserve(msg, length);
+  memcpy(msg->data + msg->length, bytes, length);
+  msg->length += length;
+}
+
+static void protoString(struct ProtoMessage *msg, uint32_t field,
+                        const char *str) {
+  protoBytes(msg, field, str, strlen(str));
+}
+
+static void protoMessage(struct ProtoMessage *msg, uint32_t field,
+                         struct ProtoMessage *inner) {
+  protoBytes(msg, field, inner->data, inner->length);
+}
+
+static void perfettoPacketInit(struct ProtoMessage *packet,
+                               uintptr_t proc, EventInt time) {
+  packet->length = 0;
+  protoVarint(packet, PF_TracePacket_timestamp, time);
+  protoVarint(packet, PF_TracePacket_sequenceId, proc + 1);
+}
+
+static void perfettoPacketWrite(struct ProtoMessage *packet) {
+  struct ProtoMessage framing = { .length = 0 };
+
+  protoRawVarint(&framing, ((EventInt)PF_Trace_packet << 3) | 2);
+  protoRawVarint(&framing, packet->length);
+
+  if (fwrite(framing.data, 1, framing.length, stdout) < framing.length
+      || fwrite(packet->data, 1, packet->length, stdout) < packet->length) {
+    fprintf(stderr, "Could not write Perfetto trace\n");
+    exit(1);
+  }
+}
+
+static void perfettoDescribeTrack(uintptr_t proc, EventInt time,
+                                  struct ProtoMessage *descriptor) {
+  struct ProtoMessage packet;
+
+  perfettoPacketInit(&packet, proc, time);
+  protoMessage(&packet, PF_TracePacket_trackDescriptor, descriptor);
+  perfettoPacketWrite(&packet);
+}
+
+static void perfettoDescribeProc(uintptr_t proc, EventInt time) {
+  struct ProtoMessage descriptor, inner;
+  char name[32];
+
+  static bool processDescribed = false;
+
+  if (!processDescribed) {
+    inner.length = 0;
+    protoVarint(&inner, PF_ProcessDescriptor_pid, PERFETTO_PID);
+    protoString(&inner, PF_ProcessDescriptor_processName, "mpl");
+
+    descriptor.length = 0;
+    protoVarint(&descriptor, PF_TrackDescriptor_uuid, PERFETTO_PROCESS_TRACK);
+    protoMessage(&descriptor, PF_TrackDescriptor_process, &inner);
+    perfettoDescribeTrack(proc, time, &descriptor);
+
+    processDescribed = true;
+  }
+
+  snprintf(name, sizeof name, "proc %" PRIuPTR, proc);
+
+  inner.length = 0;
+  protoVarint(&inner, PF_ThreadDescriptor_pid, PERFETTO_PID);
+  protoVarint(&inner, PF_ThreadDescriptor_tid, proc + 1);
+  protoString(&inner, PF_ThreadDescriptor_threadName, name);
+
+  descriptor.length = 0;
+  protoVarint(&descriptor, PF_TrackDescriptor_uuid, PERFETTO_PROC_TRACK(proc));
+  protoVarint(&descriptor, PF_TrackDescriptor_parentUuid, PERFETTO_PROCESS_TRACK);
+  protoMessage(&descriptor, PF_TrackDescriptor_thread, &inner);
+  perfettoDescribeTrack(proc, time, &descriptor);
+}
+
+static void perfettoCounter(struct Event *event, enum PerfettoCounter counter,
+                            EventInt value) {
+  uintptr_t proc = event->argptr;
+  struct ProcState *ps = getProcState(proc);
+  EventInt time = eventTimeNanoseconds(event);
+  struct ProtoMessage packet, trackEvent;
+
+  if (!(ps->countersDescribed & (1u << counter))) {
+    struct ProtoMessage descriptor, empty = { .length = 0 };
+
+    descriptor.length = 0;
+    protoVarint(&descriptor, PF_TrackDescriptor_uuid,
+                PERFETTO_COUNTER_TRACK(proc, counter));
+    protoVarint(&descriptor, PF_TrackDescriptor_parentUuid,
+                PERFETTO_PROC_TRACK(proc));
+    protoString(&descriptor, PF_TrackDescriptor_name,
+                PerfettoCounterNames[counter]);
+    protoMessage(&descriptor, PF_TrackDescriptor_counter, &empty);
+    perfettoDescribeTrack(proc, time, &descriptor);
+
+    ps->countersDescribed |= 1u << counter;
+  }
+
+  trackEvent.length = 0;
+  protoVarint(&trackEvent, PF_TrackEvent_type, PT_Counter);
+  protoVarint(&trackEvent, PF_TrackEvent_trackUuid,
+              PERFETTO_COUNTER_TRACK(proc, counter));
+  protoVarint(&trackEvent, PF_TrackEvent_counterValue, value);
+
+  perfettoPacketInit(&packet, proc, time);
+  protoMessage(&packet, PF_TracePacket_trackEvent, &trackEvent);
+  perfettoPacketWrite(&packet);
+}
+
+const char *eventKindCategory(int kind) {
+  switch (kind) {
+  case EVENT_LGC_ENTER:
+  case EVENT_LGC_LEAVE:
+  case EVENT_CGC_ENTER:
+  case EVENT_CGC_LEAVE:
+  case EVENT_PROMOTION_ENTER:
+  case EVENT_PROMOTION_LEAVE:
+  case EVENT_MANAGE_ENTANGLED_ENTER:
+  case EVENT_MANAGE_ENTANGLED_LEAVE:
+    return "GC";
+
+  case EVENT_SCHED_IDLE_ENTER:
+  case EVENT_SCHED_IDLE_LEAVE:
+  case EVENT_SCHED_WORK_ENTER:
+  case EVENT_SCHED_WORK_LEAVE:
+  case EVENT_SCHED_SLEEP_ENTER:
+  case EVENT_SCHED_SLEEP_LEAVE:
+  case EVENT_SCHED_SPAWN:
+  case EVENT_SCHED_JOIN:
+  case EVENT_SCHED_JOINFAST:
+    return "SCHED";
+
+  default:
+    return "RUNTIME";
+  }
+}
+
+/* Slices nest on the track of their processor, so e.g. PROMOTION shows up
+ * inside of LGC. */
+void writeEventPerfetto(struct Event *event) {
+  uintptr_t proc = event->argptr;
+  struct ProcState *ps = getProcState(proc);
+  EventInt time = eventTimeNanoseconds(event);
+  struct ProtoMessage packet, trackEvent;
+  char name[100];
+
+  if (!ps->described) {
+    perfettoDescribeProc(proc, time);
+    ps->described = true;
+  }
+
+  switch (event->kind) {
+  case EVENT_HEAP_OCCUPANCY:
+    perfettoCounter(event, PC_HeapSize, event->arg1);
+    perfettoCounter(event, PC_HeapAllocated, event->arg2);
+    return;
+  }
+
+  trackEvent.length = 0;
+  protoVarint(&trackEvent, PF_TrackEvent_trackUuid, PERFETTO_PROC_TRACK(proc));
+
+  switch (EventKindChromeTracingPhaseType(event->kind)) {
+    case CT_Begin:
+      protoVarint(&trackEvent, PF_TrackEvent_type, PT_SliceBegin);
+      protoString(&trackEvent, PF_TrackEvent_name,
+                  eventKindStripEnterLeave(event->kind, name, sizeof name));
+      break;
+
+    case CT_End:
+      protoVarint(&trackEvent, PF_TrackEvent_type, PT_SliceEnd);
+      break;
+
+    default:
+      if (event->kind > 0 && (size_t)event->kind < EventKindCount)
+        snprintf(name, sizeof name, "%s", EventKindStrings[event->kind]);
+      else
+        snprintf(name, sizeof name, "USER(%d)", event->kind);
+      protoVarint(&trackEvent, PF_TrackEvent_type, PT_Instant);
+      protoString(&trackEvent, PF_TrackEvent_name, name);
+      break;
+  }
+
+  protoString(&trackEvent, PF_TrackEvent_categories,
+              eventKindCategory(event->kind));
+
+  EventInt args[3] = { event->arg1, event->arg2, event->arg3 };
+  const char *argNames[3] = { "1", "2", "3" };
+  for (unsigned int i = 0; i < EventKindArity(event->kind); i++) {
+    struct ProtoMessage annotation = { .length = 0 };
+    protoString(&annotation, PF_DebugAnnotation_name, argNames[i]);
+    protoVarint(&annotation, PF_DebugAnnotation_uintValue, args[i]);
+    protoMessage(&trackEvent, PF_TrackEvent_debugAnnotations, &annotation);
+  }
+
+  perfettoPacketInit(&packet, proc, time);
+  protoMessage(&packet, PF_TracePacket_trackEvent, &trackEvent);
+  perfettoPacketWrite(&packet);
+}
+
+/* Durations, in nanoseconds, of the completed _ENTER/_LEAVE pairs of one
+ * _ENTER kind. Memory does not grow with the trace: besides the count, total
+ * and max, durations are kept in a log-linear histogram (DURATION_SUB_BUCKETS
+ * buckets per power of two), so percentiles are accurate to within
+ * 1/DURATION_SUB_BUCKETS, i.e. 12.5%. */
+#define DURATION_SUB_BITS 3
+#define DURATION_SUB_BUCKETS (1 << DURATION_SUB_BITS)
+#define DURATION_BUCKETS ((64 - DURATION_SUB_BITS + 1) * DURATION_SUB_BUCKETS)
+
+struct Durations {
+  size_t count;
+  EventInt total;
+  EventInt max;
+  size_t buckets[DURATION_BUCKETS];
+};
+
+static struct Durations durations[EventKindCount];
+
+/* Durations below DURATION_SUB_BUCKETS get a bucket each; above, a bucket
+ * covers 1/DURATION_SUB_BUCKETS of a power of two. */
+static size_t durationBucket(EventInt d) {
+  if (d < DURATION_SUB_BUCKETS)
+    return (size_t)d;
+
+  unsigned int log = 63 - (unsigned int)__builtin_clzll(d);
+  unsigned int shift = log - DURATION_SUB_BITS;
+  return (size_t)(shift + 1) * DURATION_SUB_BUCKETS
+         + (size_t)((d >> shift) & (DURATION_SUB_BUCKETS - 1));
+}
+
+/* The smallest duration that falls in the given bucket. */
+static EventInt durationBucketLow(size_t bucket) {
+  if (bucket < DURATION_SUB_BUCKETS)
+    return (EventInt)bucket;
+
+  unsigned int shift = (unsigned int)(bucket / DURATION_SUB_BUCKETS) - 1;
+  EventInt sub = (EventInt)(bucket % DURATION_SUB_BUCKETS);
+  return (DURATION_SUB_BUCKETS + sub) << shift;
+}
+
+static void recordDuration(struct Durations *d, EventInt duration) {
+  d->count++;
+  d->total += duration;
+  if (duration > d->max)
+    d->max = duration;
+  d->buckets[durationBucket(duration)]++;
+}
+
+/* The _ENTER kind matching each _LEAVE kind, or 0. */
+static int enterKindOf[EventKindCount];
+
+static void initEnterKinds(void) {
+  static bool initialized = false;
+  char leave[100], enter[100];
+
+  if (initialized)
+    return;
+  initialized = true;
+
+  for (size_t l = 1; l < EventKindCount; l++) {
+    if (EventKindStrings[l] == NULL
+        || EventKindChromeTracingPhaseType(l) != CT_End)
+      continue;
+
+    eventKindStripEnterLeave(l, leave, sizeof leave);
+    for (size_t e = 1; e < EventKindCount; e++) {
+      if (EventKindStrings[e] != NULL
+          && EventKindChromeTracingPhaseType(e) == CT_Begin
+          && 0 == strcmp(leave, eventKindStripEnterLeave(e, enter, sizeof enter)))
+        enterKindOf[l] = e;
+    }
+  }
+}
+
+void recordEventSummary(struct Event *event) {
+  struct ProcState *ps = getProcState(event->argptr);
+  EventInt time = eventTimeNanoseconds(event);
+  int kind = event->kind;
+
+  initEnterKinds();
+
+  if (!(kind > 0 && (size_t)kind < EventKindCount))
+    return;
+
+  switch (EventKindChromeTracingPhaseType(kind)) {
+  case CT_Begin:
+    ps->enteredAt[kind] = time + 1;
+    break;
+
+  case CT_End: {
+    int enter = enterKindOf[kind];
+    if (enter == 0 || ps->enteredAt[enter] == 0)
+      break;
+
+    recordDuration(&durations[enter], time + 1 - ps->enteredAt[enter]);
+    ps->enteredAt[enter] = 0;
+    break;
+  }
+
+  default:
+    break;
+  }
+}
+
+/* Percentile of durations, in microseconds: the midpoint of the histogram
+ * bucket holding it, but never more than the max. */
+static double percentileMicroseconds(struct Durations *d, double p) {
+  size_t rank = (size_t)(p / 100.0 * (double)(d->count - 1) + 0.5);
+  size_t seen = 0;
+
+  for (size_t b = 0; b < DURATION_BUCKETS; b++) {
+    seen += d->buckets[b];
+    if (seen > rank) {
+      EventInt low = durationBucketLow(b);
+      EventInt high = (b + 1 < DURATION_BUCKETS) ? durationBucketLow(b + 1) : d->max + 1;
+      EventInt mid = low + (high - 1 - low) / 2;
+      return (double)(mid < d->max ? mid : d->max) / 1E3;
+    }
+  }
+
+  return (double)d->max / 1E3;
+}
+
+void printSummary(void) {
+  char name[100];
+
+  printf("%-24s %10s %12s %10s %10s %10s %10s %10s\n",
+         "event", "count", "total(ms)", "mean(us)",
+         "p50(us)", "p90(us)", "p99(us)", "max(us)");
+
+  for (size_t k = 0; k < EventKindCount; k++) {
+    struct Durations *d = &durations[k];
+    if (d->count == 0)
+      continue;
+
+    printf("%-24s %10zu %12.3f %10.3f %10.3f %10.3f %10.3f %10.3f\n",
+           eventKindStripEnterLeave(k, name, sizeof name),
+           d->count,
+           (double)d->total / 1E6,
+           (double)d->total / 1E3 / (double)d->count,
+           percentileMicroseconds(d, 50.0),
+           percentileMicroseconds(d, 90.0),
+           percentileMicroseconds(d, 99.0),
+           (double)d->max / 1E3);
+  }
+}
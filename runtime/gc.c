@@ -47,6 +47,7 @@ extern C_Pthread_Key_t gcstate_key;
 #include "gc/gdtoa-multiple-threads-defs.c"
 
 #include "gc/assign.c"
+#include "gc/async-io.c"
 #include "gc/atomic.c"
 #include "gc/block-allocator.c"
 #include "gc/call-stack.c"
@@ -84,6 +85,7 @@ extern C_Pthread_Key_t gcstate_key;
 #include "gc/invariant.c"
 #include "gc/local-heap.c"
 #include "gc/logger.c"
+#include "gc/metrics.c"
 #include "gc/model.c"
 #include "gc/new-object.c"
 #include "gc/object-size.c"
@@ -93,6 +95,7 @@ extern C_Pthread_Key_t gcstate_key;
 #include "gc/parallel.c"
 #include "gc/pin.c"
 #include "gc/pointer.c"
+#include "gc/prefetch-queue.c"
 #include "gc/profiling.c"
 #include "gc/concurrent-list.c"
 #include "gc/remembered-set.c"
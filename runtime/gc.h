@@ -37,6 +37,7 @@ typedef GC_state GCState_t;
 #include "gc/model.h"
 #include "gc/pointer.h"
 #include "gc/objptr.h"
+#include "gc/prefetch-queue.h"
 #include "gc/object.h"
 #include "gc/decheck.h"
 #include "gc/sequence.h"
@@ -99,5 +100,7 @@ typedef GC_state GCState_t;
 #include "gc/gap.h"
 // #include "gc/deferred-promote.h"
 #include "gc/tracing-hooks.h"
+#include "gc/metrics.h"
+#include "gc/async-io.h"
 
 #endif /* _MLTON_GC_H_ */
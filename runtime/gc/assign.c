@@ -95,6 +95,106 @@ static inline bool decheck_opt_fast (GC_state s, pointer p) {
 }
 
 
+/* The snapshot half of the write barrier: if the value about to be
+ * overwritten lives in a heap that is being concurrently collected and has
+ * not yet been marked, hand it to the collector. Callers check that
+ * dstHH->depth >= 1 and that a deque exists. */
+static inline void snapshotOverwritten(
+  GC_state s,
+  HM_HierarchicalHeap dstHH,
+  objptr readVal)
+{
+  if (!isObjptr(readVal))
+    return;
+
+  pointer currp = objptrToPointer(readVal, NULL);
+  HM_HierarchicalHeap currHH = HM_getLevelHead(HM_getChunkOf(currp));
+  if (currHH->depth == dstHH->depth
+      && HM_HH_getConcurrentPack(currHH)->ccstate != CC_UNREG
+      && !CC_isPointerMarked(currp))
+  {
+    HM_HH_addRootForCollector(s, currHH, currp);
+  }
+}
+
+/* The down-pointer half of the write barrier, for a src that is an objptr
+ * and a dst other than the deque. *dstDecheck caches whether dst passes the
+ * disentanglement check (-1 = not yet known), so that a run of writes into
+ * the same object checks it at most once. */
+static void rememberWritten(
+  GC_state s,
+  objptr dst,
+  HM_HierarchicalHeap dstHH,
+  objptr src,
+  int *dstDecheck)
+{
+  pointer dstp = objptrToPointer(dst, NULL);
+  pointer srcp = objptrToPointer(src, NULL);
+
+  HM_HierarchicalHeap srcHH = HM_getLevelHead(HM_getChunkOf(srcp));
+  if (srcHH == dstHH) {
+    /* internal pointers are always traced */
+    return;
+  }
+
+  uint32_t dd = dstHH->depth;
+  bool src_de = decheck_opt_fast(s, srcp) || decheck(s, src);
+  if (src_de) {
+    if (*dstDecheck < 0) {
+      *dstDecheck = decheck_opt_fast(s, dstp) || decheck(s, dst);
+    }
+    bool dst_de = *dstDecheck;
+    if (dst_de) {
+      uint32_t sd = srcHH->depth;
+      /* up pointer (snapshotted by the closure)
+       * or internal (within a chain) pointer to a snapshotted heap
+       */
+      if(dd > sd ||
+        ((HM_HH_getConcurrentPack(srcHH)->ccstate != CC_UNREG) &&
+        dd == sd))
+      {
+        return;
+      }
+
+      uint32_t unpinDepth = dd;
+      bool success = pinObject(s, src, unpinDepth, PIN_DOWN);
+
+      if (success || dd == unpinDepthOf(src))
+      {
+        struct HM_remembered remElem_ = {.object = src, .from = dst};
+        HM_remembered remElem = &remElem_;
+
+        HM_HierarchicalHeap shh = HM_HH_getHeapAtDepth(s, getThreadCurrent(s), sd);
+        assert(NULL != shh);
+        assert(HM_HH_getConcurrentPack(shh)->ccstate == CC_UNREG);
+
+        HM_HH_rememberAtLevel(shh, remElem, false);
+        LOG(LM_HH_PROMOTION, LL_INFO,
+            "remembered downptr %" PRIu32 "->%" PRIu32 " from " FMTOBJPTR " to " FMTOBJPTR,
+            dstHH->depth, srcHH->depth,
+            dst, src);
+      }
+
+      if (dd > 0 && !ES_contains(NULL, dst)) {
+        HM_HierarchicalHeap dhh = HM_HH_getHeapAtDepth(s, getThreadCurrent(s), dd);
+        ES_add(s, HM_HH_getSuspects(dhh), dst);
+      }
+    }
+    else if(dstHH->depth != 0) {
+      s->cumulativeStatistics->numEntanglements++;
+
+      LOCAL_USED_FOR_ASSERT objptr newsrc;
+      newsrc = manage_entangled (s, src, HM_getChunkOf(dstp)->decheckState);
+      // this better be true... otherwise everything is going to explode
+      assert(newsrc == src);
+    }
+
+  } else {
+    traverseAndCheck(s, &src, src, NULL);
+  }
+}
+
+
 void Assignable_writeBarrier(
   GC_state s,
   objptr dst,
@@ -103,7 +203,7 @@ void Assignable_writeBarrier(
 {
   assert(isObjptr(dst));
   pointer dstp = objptrToPointer(dst, NULL);
-  pointer srcp = objptrToPointer(src, NULL);
+  LOCAL_USED_FOR_ASSERT pointer srcp = objptrToPointer(src, NULL);
 
   assert (!hasFwdPtr(dstp));
   assert (!isObjptr(src) || !hasFwdPtr(srcp));
@@ -141,16 +241,8 @@ void Assignable_writeBarrier(
 
   HM_HierarchicalHeap dstHH = HM_getLevelHead(HM_getChunkOf(dstp));
 
-  objptr readVal = __atomic_load_n(field, __ATOMIC_ACQUIRE);
-  if (dstHH->depth >= 1 && isObjptr(readVal) && s->wsQueueTop!=BOGUS_OBJPTR) {
-    pointer currp = objptrToPointer(readVal, NULL);
-    HM_HierarchicalHeap currHH = HM_getLevelHead(HM_getChunkOf(currp));
-    if (currHH->depth == dstHH->depth
-        && HM_HH_getConcurrentPack(currHH)->ccstate != CC_UNREG
-        && !CC_isPointerMarked(currp))
-    {
-      HM_HH_addRootForCollector(s, currHH, currp);
-    }
+  if (dstHH->depth >= 1 && s->wsQueueTop != BOGUS_OBJPTR) {
+    snapshotOverwritten(s, dstHH, __atomic_load_n(field, __ATOMIC_ACQUIRE));
   }
 
   /* If src does not reference an object, then no need to check for
@@ -164,64 +256,63 @@ void Assignable_writeBarrier(
     return;
   }
 
-  HM_HierarchicalHeap srcHH = HM_getLevelHead(HM_getChunkOf(srcp));
-  if (srcHH == dstHH) {
-    /* internal pointers are always traced */
-    return;
-  }
+  int dstDecheck = -1;
+  rememberWritten(s, dst, dstHH, src, &dstDecheck);
+}
 
-  uint32_t dd = dstHH->depth;
-  bool src_de = decheck_opt_fast(s, srcp) || decheck(s, src);
-  if (src_de) {
-    bool dst_de = decheck_opt_fast(s, dstp) || decheck(s, dst);
-    if (dst_de) {
-      uint32_t sd = srcHH->depth;
-      /* up pointer (snapshotted by the closure)
-       * or internal (within a chain) pointer to a snapshotted heap
-       */
-      if(dd > sd ||
-        ((HM_HH_getConcurrentPack(srcHH)->ccstate != CC_UNREG) &&
-        dd == sd))
-      {
-        return;
-      }
+void Assignable_writeBarrierBeforeRange(
+  GC_state s,
+  objptr dst,
+  pointer first,
+  size_t numElements,
+  size_t eltSize,
+  uint16_t bytesNonObjptrs,
+  uint16_t numObjptrs)
+{
+  pointer dstp = objptrToPointer(dst, NULL);
+  assert (!hasFwdPtr(dstp));
 
-      uint32_t unpinDepth = dd;
-      bool success = pinObject(s, src, unpinDepth, PIN_DOWN);
+  HM_HierarchicalHeap dstHH = HM_getLevelHead(HM_getChunkOf(dstp));
+  if (dstHH->depth < 1 || s->wsQueueTop == BOGUS_OBJPTR)
+    return;
 
-      if (success || dd == unpinDepthOf(src))
-      {
-        struct HM_remembered remElem_ = {.object = src, .from = dst};
-        HM_remembered remElem = &remElem_;
+  for (size_t i = 0; i < numElements; i++) {
+    pointer elt = first + i * eltSize + bytesNonObjptrs;
+    for (uint16_t j = 0; j < numObjptrs; j++) {
+      objptr* field = (objptr*)(elt + j * OBJPTR_SIZE);
+      snapshotOverwritten(s, dstHH, __atomic_load_n(field, __ATOMIC_ACQUIRE));
+    }
+  }
+}
 
-        HM_HierarchicalHeap shh = HM_HH_getHeapAtDepth(s, getThreadCurrent(s), sd);
-        assert(NULL != shh);
-        assert(HM_HH_getConcurrentPack(shh)->ccstate == CC_UNREG);
+void Assignable_writeBarrierAfterRange(
+  GC_state s,
+  objptr dst,
+  pointer first,
+  size_t numElements,
+  size_t eltSize,
+  uint16_t bytesNonObjptrs,
+  uint16_t numObjptrs)
+{
+  /* deque down-pointers are handled separately during collection. */
+  if (dst == s->wsQueue)
+    return;
 
-        HM_HH_rememberAtLevel(shh, remElem, false);
-        LOG(LM_HH_PROMOTION, LL_INFO,
-            "remembered downptr %" PRIu32 "->%" PRIu32 " from " FMTOBJPTR " to " FMTOBJPTR,
-            dstHH->depth, srcHH->depth,
-            dst, src);
-      }
+  pointer dstp = objptrToPointer(dst, NULL);
+  assert (!hasFwdPtr(dstp));
 
-      if (dd > 0 && !ES_contains(NULL, dst)) {
-        HM_HierarchicalHeap dhh = HM_HH_getHeapAtDepth(s, getThreadCurrent(s), dd);
-        ES_add(s, HM_HH_getSuspects(dhh), dst);
-      }
-    }
-    else if(dstHH->depth != 0) {
-      s->cumulativeStatistics->numEntanglements++;
+  HM_HierarchicalHeap dstHH = HM_getLevelHead(HM_getChunkOf(dstp));
+  int dstDecheck = -1;
 
-      LOCAL_USED_FOR_ASSERT objptr newsrc;
-      newsrc = manage_entangled (s, src, HM_getChunkOf(dstp)->decheckState);
-      // this better be true... otherwise everything is going to explode
-      assert(newsrc == src);
+  for (size_t i = 0; i < numElements; i++) {
+    pointer elt = first + i * eltSize + bytesNonObjptrs;
+    for (uint16_t j = 0; j < numObjptrs; j++) {
+      objptr src = *(objptr*)(elt + j * OBJPTR_SIZE);
+      if (isObjptr(src)) {
+        assert (!hasFwdPtr(objptrToPointer(src, NULL)));
+        rememberWritten(s, dst, dstHH, src, &dstDecheck);
+      }
     }
-
-  } else {
-    traverseAndCheck(s, &src, src, NULL);
   }
-
 }
 
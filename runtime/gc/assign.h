@@ -10,6 +10,34 @@
 #ifndef ASSIGN_H
 #define ASSIGN_H
 
+#if (defined (MLTON_GC_INTERNAL_FUNCS))
+
+/* Write barrier for a bulk update of numElements consecutive elements of
+ * the sequence dst, starting at first. The "before" half must run before
+ * the elements are overwritten and the "after" half once they hold their
+ * new values; together they are equivalent to Assignable_writeBarrier on
+ * every objptr field of the range, but look up the destination's heap and
+ * check the destination for entanglement only once. */
+void Assignable_writeBarrierBeforeRange(
+  GC_state s,
+  objptr dst,
+  pointer first,
+  size_t numElements,
+  size_t eltSize,
+  uint16_t bytesNonObjptrs,
+  uint16_t numObjptrs);
+
+void Assignable_writeBarrierAfterRange(
+  GC_state s,
+  objptr dst,
+  pointer first,
+  size_t numElements,
+  size_t eltSize,
+  uint16_t bytesNonObjptrs,
+  uint16_t numObjptrs);
+
+#endif /* MLTON_GC_INTERNAL_FUNCS */
+
 #if (defined (MLTON_GC_INTERNAL_BASIS))
 
 #include "hierarchical-heap.h"
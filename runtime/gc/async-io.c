@@ -0,0 +1,206 @@
+/* MLton is released under a HPND-style license.
+ * See the file MLton-LICENSE for details.
+ */
+
+#if (defined (MLTON_GC_INTERNAL_FUNCS))
+
+static pthread_mutex_t aioQueueLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t aioQueueNonEmpty = PTHREAD_COND_INITIALIZER;
+static GC_aioBatch aioQueueHead = NULL;
+static GC_aioBatch aioQueueTail = NULL;
+static uint32_t aioNumHelpers = 0;
+
+static int64_t aioPerform(struct GC_aioRequest *r) {
+  size_t done = 0;
+
+  while (done < r->length) {
+    ssize_t n =
+      r->isWrite
+      ? pwrite(r->fd, r->staging + done, r->length - done, r->offset + done)
+      : pread(r->fd, r->staging + done, r->length - done, r->offset + done);
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      return -(int64_t)errno;
+    }
+    if (n == 0)
+      break; /* end of file */
+    done += (size_t)n;
+  }
+
+  return (int64_t)done;
+}
+
+static void aioComplete(GC_aioBatch b) {
+  char c = 0;
+  while (write(b->completionPipe[1], &c, 1) < 0 && errno == EINTR)
+    ;
+  __atomic_store_n(&(b->completed), TRUE, __ATOMIC_RELEASE);
+}
+
+static void *aioHelperLoop(__attribute__ ((unused)) void *arg) {
+  while (TRUE) {
+    pthread_mutex_lock(&aioQueueLock);
+    while (NULL == aioQueueHead)
+      pthread_cond_wait(&aioQueueNonEmpty, &aioQueueLock);
+
+    GC_aioBatch b = aioQueueHead;
+    uint32_t i = b->nextToIssue++;
+    if (b->nextToIssue == b->numRequests) {
+      aioQueueHead = b->nextInQueue;
+      if (NULL == aioQueueHead)
+        aioQueueTail = NULL;
+    }
+    pthread_mutex_unlock(&aioQueueLock);
+
+    b->requests[i].result = aioPerform(&(b->requests[i]));
+
+    if (1 == __atomic_fetch_sub(&(b->numPending), 1, __ATOMIC_ACQ_REL))
+      aioComplete(b);
+  }
+  return NULL;
+}
+
+/* Called with aioQueueLock held. */
+static void aioStartHelpers(GC_state s) {
+  sigset_t all, old;
+
+  /* Like the metrics server, helpers must never run signal handlers meant
+   * for the workers. */
+  sigfillset(&all);
+  pthread_sigmask(SIG_SETMASK, &all, &old);
+  while (aioNumHelpers < s->controls->aioThreads) {
+    pthread_t helper;
+    if (pthread_create(&helper, NULL, aioHelperLoop, NULL))
+      die("aio-threads: could not start helper thread");
+    pthread_detach(helper);
+    aioNumHelpers++;
+  }
+  pthread_sigmask(SIG_SETMASK, &old, NULL);
+}
+
+#endif /* MLTON_GC_INTERNAL_FUNCS */
+
+pointer GC_aioBatchNew(uint32_t capacity) {
+  GC_aioBatch b =
+    malloc_safe(sizeof(struct GC_aioBatch)
+                + capacity * sizeof(struct GC_aioRequest));
+  if (pipe(b->completionPipe) < 0) {
+    free(b);
+    return NULL;
+  }
+  fcntl(b->completionPipe[0], F_SETFD, FD_CLOEXEC);
+  fcntl(b->completionPipe[1], F_SETFD, FD_CLOEXEC);
+
+  b->nextInQueue = NULL;
+  b->capacity = capacity;
+  b->numRequests = 0;
+  b->nextToIssue = 0;
+  b->numPending = 0;
+  b->completed = FALSE;
+  return (pointer)b;
+}
+
+static uint32_t aioBatchAdd(
+  GC_aioBatch b,
+  int fd,
+  bool isWrite,
+  size_t length,
+  int64_t offset)
+{
+  if (b->numRequests >= b->capacity)
+    die("MPLFile.Async: batch is full (%"PRIu32" requests)", b->capacity);
+
+  uint32_t i = b->numRequests++;
+  struct GC_aioRequest *r = &(b->requests[i]);
+  r->fd = fd;
+  r->isWrite = isWrite;
+  r->length = length;
+  r->offset = (off_t)offset;
+  r->staging = (0 == length) ? NULL : malloc_safe(length);
+  r->result = 0;
+  return i;
+}
+
+uint32_t GC_aioBatchAddRead(
+  pointer batch,
+  int fd,
+  size_t length,
+  int64_t offset)
+{
+  return aioBatchAdd((GC_aioBatch)batch, fd, FALSE, length, offset);
+}
+
+uint32_t GC_aioBatchAddWrite(
+  pointer batch,
+  int fd,
+  pointer src,
+  size_t srcOffset,
+  size_t length,
+  int64_t offset)
+{
+  GC_aioBatch b = (GC_aioBatch)batch;
+  uint32_t i = aioBatchAdd(b, fd, TRUE, length, offset);
+  if (length > 0)
+    memcpy(b->requests[i].staging, src + srcOffset, length);
+  return i;
+}
+
+void GC_aioBatchSubmit(GC_state s, pointer batch) {
+  GC_aioBatch b = (GC_aioBatch)batch;
+
+  b->numPending = b->numRequests;
+  if (0 == b->numRequests) {
+    aioComplete(b);
+    return;
+  }
+
+  pthread_mutex_lock(&aioQueueLock);
+  if (aioNumHelpers < s->controls->aioThreads)
+    aioStartHelpers(s);
+  if (NULL == aioQueueTail)
+    aioQueueHead = b;
+  else
+    aioQueueTail->nextInQueue = b;
+  aioQueueTail = b;
+  pthread_cond_broadcast(&aioQueueNonEmpty);
+  pthread_mutex_unlock(&aioQueueLock);
+}
+
+int GC_aioBatchCompletionFd(pointer batch) {
+  return ((GC_aioBatch)batch)->completionPipe[0];
+}
+
+Bool_t GC_aioBatchIsDone(pointer batch) {
+  GC_aioBatch b = (GC_aioBatch)batch;
+  return __atomic_load_n(&(b->completed), __ATOMIC_ACQUIRE);
+}
+
+void GC_aioBatchWait(pointer batch) {
+  while (!GC_aioBatchIsDone(batch))
+    GC_pollerBlock(GC_aioBatchCompletionFd(batch), GC_POLLER_READABLE);
+}
+
+int64_t GC_aioBatchResult(pointer batch, uint32_t i) {
+  GC_aioBatch b = (GC_aioBatch)batch;
+  assert(i < b->numRequests);
+  return b->requests[i].result;
+}
+
+void GC_aioBatchCopyOut(pointer batch, uint32_t i, pointer dst, size_t dstOffset) {
+  GC_aioBatch b = (GC_aioBatch)batch;
+  assert(i < b->numRequests);
+  struct GC_aioRequest *r = &(b->requests[i]);
+  if (r->result > 0)
+    memcpy(dst + dstOffset, r->staging, (size_t)r->result);
+}
+
+void GC_aioBatchFree(pointer batch) {
+  GC_aioBatch b = (GC_aioBatch)batch;
+  assert(GC_aioBatchIsDone(batch));
+  for (uint32_t i = 0; i < b->numRequests; i++)
+    free(b->requests[i].staging);
+  close(b->completionPipe[0]);
+  close(b->completionPipe[1]);
+  free(b);
+}
@@ -0,0 +1,78 @@
+/* MLton is released under a HPND-style license.
+ * See the file MLton-LICENSE for details.
+ */
+
+/** Asynchronous file I/O for MPLFile.Async. Reads and writes at explicit
+  * offsets are grouped into batches. A submitted batch is served by a pool
+  * of @mpl aio-threads runtime threads (started on first use) issuing
+  * pread/pwrite, so page faults and disk latency stall a helper thread
+  * rather than a worker.
+  *
+  * Data moves through staging buffers owned by the batch: the heap may move
+  * the ML arrays involved at any time, so helpers never touch the heap.
+  * Writes are copied in when added, and reads are copied out after the
+  * batch completes.
+  *
+  * Each batch has a completion descriptor that becomes (and stays) readable
+  * once every request of the batch has finished, so that a scheduler can
+  * park the waiting thread instead of blocking its worker.
+  */
+
+#ifndef ASYNC_IO_H_
+#define ASYNC_IO_H_
+
+#if (defined (MLTON_GC_INTERNAL_TYPES))
+
+struct GC_aioRequest {
+  int fd;
+  bool isWrite;
+  size_t length;
+  off_t offset;
+  pointer staging;
+  /* bytes transferred, or -errno */
+  int64_t result;
+};
+
+typedef struct GC_aioBatch {
+  struct GC_aioBatch *nextInQueue;
+  uint32_t capacity;
+  uint32_t numRequests;
+  /* next request to hand to a helper; protected by the queue lock */
+  uint32_t nextToIssue;
+  uint32_t numPending;
+  /* Set once the last request has finished and the completion descriptor
+   * has been signalled, after which the batch may be freed. */
+  bool completed;
+  /* [0] becomes readable on completion */
+  int completionPipe[2];
+  struct GC_aioRequest requests[];
+} *GC_aioBatch;
+
+#endif /* MLTON_GC_INTERNAL_TYPES */
+
+#if (defined (MLTON_GC_INTERNAL_FUNCS))
+
+static void *aioHelperLoop(void *arg);
+
+#endif /* MLTON_GC_INTERNAL_FUNCS */
+
+/* Returns a batch with room for capacity requests, or NULL (with errno
+ * set) if its completion descriptor could not be created. */
+PRIVATE pointer GC_aioBatchNew (uint32_t capacity);
+/* Add a read of length bytes at offset. Returns the request's index. */
+PRIVATE uint32_t GC_aioBatchAddRead (pointer batch, int fd, size_t length, int64_t offset);
+/* Add a write of length bytes, taken now from src+srcOffset, at offset.
+ * Returns the request's index. */
+PRIVATE uint32_t GC_aioBatchAddWrite (pointer batch, int fd, pointer src, size_t srcOffset, size_t length, int64_t offset);
+PRIVATE void GC_aioBatchSubmit (GC_state s, pointer batch);
+PRIVATE int GC_aioBatchCompletionFd (pointer batch);
+PRIVATE Bool_t GC_aioBatchIsDone (pointer batch);
+/* Block the calling thread until the batch is done. */
+PRIVATE void GC_aioBatchWait (pointer batch);
+PRIVATE int64_t GC_aioBatchResult (pointer batch, uint32_t i);
+/* Copy the bytes read by request i to dst+dstOffset. */
+PRIVATE void GC_aioBatchCopyOut (pointer batch, uint32_t i, pointer dst, size_t dstOffset);
+/* Release a batch that is done. */
+PRIVATE void GC_aioBatchFree (pointer batch);
+
+#endif /* ASYNC_IO_H_ */
@@ -146,6 +146,73 @@ static void initBlockAllocator(GC_state s, BlockAllocator ball) {
     ball->megaBlockSizeClass[i].firstMegaBlock = NULL;
   }
   pthread_mutex_init(&(ball->megaBlockLock), NULL);
+  ball->heapPressure = HEAP_PRESSURE_NONE;
+}
+
+
+/** Number of blocks currently mapped across all allocators. Read without
+  * synchronization, so this is only approximate.
+  */
+static size_t currentBlocksMapped(GC_state s) {
+  size_t mapped;
+  size_t globalMapped;
+  size_t released;
+  size_t globalReleased;
+  size_t allocated[NUM_BLOCK_PURPOSES];
+  size_t freed[NUM_BLOCK_PURPOSES];
+  queryCurrentBlockUsage(
+    s,
+    &mapped,
+    &globalMapped,
+    &released,
+    &globalReleased,
+    allocated,
+    freed);
+  return (released > mapped) ? 0 : mapped - released;
+}
+
+
+/** How many more blocks may be mapped without exceeding the max-heap. */
+static size_t heapLimitRoom(GC_state s) {
+  if (0 == s->controls->maxHeap)
+    return SIZE_MAX;
+
+  size_t limit = s->controls->maxHeap / s->controls->blockSize;
+  size_t mapped = currentBlocksMapped(s);
+  return (mapped >= limit) ? 0 : limit - mapped;
+}
+
+
+#define HEAP_LIMIT_MAX_WAITS 20
+
+/** Called when no more memory can be mapped. Without a max-heap this is
+  * fatal. Otherwise, back off (1ms, doubling up to 64ms) so that other
+  * processors, which the pressure sampler has already pushed to collect,
+  * get a chance to free blocks. The caller retries after each wait and gives
+  * up after HEAP_LIMIT_MAX_WAITS of them, i.e. after about a second.
+  */
+static void waitForHeapRoom(GC_state s, size_t numBlocks, uint32_t attempt) {
+  if (0 == s->controls->maxHeap)
+    DIE("ran out of space!");
+
+  assert(attempt < HEAP_LIMIT_MAX_WAITS);
+  s->cumulativeStatistics->numHeapLimitWaits++;
+
+  LOG(LM_BLOCK_ALLOCATOR, LL_INFO,
+    "at max-heap; waiting for %zu blocks (attempt %u)",
+    numBlocks,
+    attempt);
+
+  struct timespec wait;
+  wait.tv_sec = 0;
+  wait.tv_nsec = (1000L * 1000L) << min(attempt, 6);
+  nanosleep(&wait, NULL);
+}
+
+static void dieAtHeapLimit(GC_state s, size_t numBlocks) {
+  DIE("ran out of space: %zu more blocks would exceed max-heap (%s bytes)",
+      numBlocks,
+      uintmaxToCommaString(s->controls->maxHeap));
 }
 
 
@@ -215,20 +282,29 @@ static void setSuperBlockSizeClass(GC_state s, SuperBlock sb, int sizeClass) {
 }
 
 
-static void mmapNewSuperBlocks(
+/** Returns FALSE if nothing could be mapped, either because mmap failed or
+  * because not even one more superblock fits under the max-heap.
+  */
+static bool mmapNewSuperBlocks(
   GC_state s,
   BlockAllocator ball)
 {
   size_t oneWidth = s->controls->blockSize * (1 + SUPERBLOCK_SIZE(s));
   size_t count = 1 + (s->controls->allocBlocksMinSize-1) / oneWidth;
   assert(count * oneWidth >= s->controls->allocBlocksMinSize);
+
+  size_t room = heapLimitRoom(s) / (1 + SUPERBLOCK_SIZE(s));
+  if (0 == room)
+    return FALSE;
+  count = min(count, room);
+
   pointer start = GC_mmapAnon(NULL, count * oneWidth);
   if (MAP_FAILED == start) {
     /** Try again, but the minimum amount of space we actually need. */
     count = 1;
     start = GC_mmapAnon(NULL, oneWidth);
     if (MAP_FAILED == start)
-      DIE("ran out of space!");
+      return FALSE;
   }
   assert(isAligned((size_t)start, s->controls->blockSize));
 
@@ -244,6 +320,7 @@ static void mmapNewSuperBlocks(
   }
 
   ball->numBlocksMapped += count*(SUPERBLOCK_SIZE(s));
+  return TRUE;
 }
 
 
@@ -272,6 +349,7 @@ static Blocks allocateInSuperBlock(
     result->container = sb;
     result->numBlocks = 1 << sb->sizeClass;
     result->purpose = purpose;
+    result->knownZero = FALSE;
     return result;
   }
 
@@ -288,6 +366,7 @@ static Blocks allocateInSuperBlock(
   bs->container = sb;
   bs->numBlocks = (1 << sb->sizeClass);
   bs->purpose = purpose;
+  bs->knownZero = FALSE;
 
   return bs;
 }
@@ -493,6 +572,10 @@ static MegaBlock tryFindMegaBlock(
 
 static MegaBlock mmapNewMegaBlock(GC_state s, size_t numBlocks, enum BlockPurpose purpose)
 {
+  if (heapLimitRoom(s) < numBlocks) {
+    return NULL;
+  }
+
   pointer start = GC_mmapAnon(NULL, s->controls->blockSize * numBlocks);
   if (MAP_FAILED == start) {
     return NULL;
@@ -531,12 +614,19 @@ Blocks allocateBlocksWithPurpose(GC_state s, size_t numBlocks, enum BlockPurpose
       */
 
     MegaBlock mb = tryFindMegaBlock(s, numBlocks, class, purpose);
+    bool fresh = FALSE;
 
-    if (NULL == mb)
+    for (uint32_t attempt = 0; NULL == mb; attempt++) {
       mb = mmapNewMegaBlock(s, numBlocks, purpose);
-
-    if (NULL == mb)
-      DIE("ran out of space!");
+      if (NULL != mb) {
+        fresh = TRUE;
+        break;
+      }
+      if (attempt == HEAP_LIMIT_MAX_WAITS)
+        dieAtHeapLimit(s, numBlocks);
+      waitForHeapRoom(s, numBlocks, attempt);
+      mb = tryFindMegaBlock(s, numBlocks, class, purpose);
+    }
 
     size_t actualNumBlocks = mb->numBlocks;
     assert(actualNumBlocks >= numBlocks);
@@ -544,6 +634,7 @@ Blocks allocateBlocksWithPurpose(GC_state s, size_t numBlocks, enum BlockPurpose
     bs->container = NULL;
     bs->numBlocks = actualNumBlocks;
     bs->purpose = purpose;
+    bs->knownZero = fresh;
     return bs;
   }
 
@@ -559,11 +650,22 @@ Blocks allocateBlocksWithPurpose(GC_state s, size_t numBlocks, enum BlockPurpose
   }
 
   /** If both local fails, we need to mmap new superchunks. */
-  mmapNewSuperBlocks(s, local);
+  for (uint32_t attempt = 0; TRUE; attempt++) {
+    if (mmapNewSuperBlocks(s, local)) {
+      result = tryAllocateAndAdjustSuperBlocks(s, local, class, purpose);
+      if (result == NULL) {
+        DIE("Ran out of space for new superblocks!");
+      }
+      break;
+    }
 
-  result = tryAllocateAndAdjustSuperBlocks(s, local, class, purpose);
-  if (result == NULL) {
-    DIE("Ran out of space for new superblocks!");
+    if (attempt == HEAP_LIMIT_MAX_WAITS)
+      dieAtHeapLimit(s, (size_t)1 << class);
+    waitForHeapRoom(s, (size_t)1 << class, attempt);
+    clearOutOtherFrees(s);
+    result = tryAllocateAndAdjustSuperBlocks(s, local, class, purpose);
+    if (result != NULL)
+      break;
   }
 
   assertBlockAllocatorOkay(s, local);
@@ -807,6 +909,106 @@ void logCurrentBlockUsage(
     freed[BLOCK_FOR_UNKNOWN_PURPOSE]);
 }
 
+static void updateHeapPressure(
+  GC_state s,
+  __attribute__((unused)) struct timespec *now,
+  __attribute__((unused)) void *env)
+{
+  if (0 == s->controls->maxHeap)
+    return;
+
+  size_t mapped;
+  size_t globalMapped;
+  size_t released;
+  size_t globalReleased;
+  size_t allocated[NUM_BLOCK_PURPOSES];
+  size_t freed[NUM_BLOCK_PURPOSES];
+  queryCurrentBlockUsage(
+    s,
+    &mapped,
+    &globalMapped,
+    &released,
+    &globalReleased,
+    allocated,
+    freed);
+
+  /** Blocks in use rather than mapped: collections can bring this down,
+    * whereas mapped blocks are mostly kept for reuse, so a level computed
+    * from them would never drop again. See below for the mapped limit.
+    */
+  size_t inUse = 0;
+  for (enum BlockPurpose p = 0; p < NUM_BLOCK_PURPOSES; p++) {
+    if (allocated[p] > freed[p])
+      inUse += allocated[p] - freed[p];
+  }
+
+  double fraction =
+    (double)(inUse * s->controls->blockSize) / (double)s->controls->maxHeap;
+
+  uint32_t pressure = HEAP_PRESSURE_NONE;
+  if (fraction >= 0.95)
+    pressure = HEAP_PRESSURE_THROTTLE;
+  else if (fraction >= 0.85)
+    pressure = HEAP_PRESSURE_CC;
+  else if (fraction >= 0.7)
+    pressure = HEAP_PRESSURE_COLLECT;
+
+  /** The max-heap itself limits mapped blocks (heapLimitRoom), which are
+    * rarely unmapped and so only ever go up. Once not even one more
+    * superblock may be mapped, allocation depends entirely on free blocks
+    * of a suitable size class, and can fail even when few blocks are in
+    * use (fragmentation). Collect concurrently then, so that whole
+    * superblocks are emptied.
+    */
+  if (heapLimitRoom(s) < 1 + SUPERBLOCK_SIZE(s) && pressure < HEAP_PRESSURE_CC)
+    pressure = HEAP_PRESSURE_CC;
+
+  if (pressure != s->blockAllocatorGlobal->heapPressure) {
+    LOG(LM_BLOCK_ALLOCATOR, LL_INFO,
+      "heap pressure %u (%.1f%% of max-heap in use)",
+      pressure,
+      100.0 * fraction);
+    s->blockAllocatorGlobal->heapPressure = pressure;
+  }
+}
+
+
+Sampler newHeapPressureSampler(GC_state s) {
+  struct SamplerClosure func;
+  func.fun = updateHeapPressure;
+  func.env = NULL;
+
+  struct timespec desiredInterval;
+  desiredInterval.tv_sec = 0;
+  desiredInterval.tv_nsec = 10 * 1000 * 1000; // 10 ms
+  Sampler result = malloc(sizeof(struct Sampler));
+  initSampler(s, result, &func, &desiredInterval);
+
+  return result;
+}
+
+
+static inline enum HeapPressure currentHeapPressure(GC_state s) {
+  return (enum HeapPressure)s->blockAllocatorGlobal->heapPressure;
+}
+
+
+void throttleUnderHeapPressure(GC_state s) {
+  if (0 == s->controls->maxHeap)
+    return;
+
+  maybeSample(s, s->heapPressureSampler);
+  if (currentHeapPressure(s) < HEAP_PRESSURE_THROTTLE)
+    return;
+
+  s->cumulativeStatistics->numHeapThrottles++;
+  struct timespec wait;
+  wait.tv_sec = 0;
+  wait.tv_nsec = 100 * 1000; // 100 us
+  nanosleep(&wait, NULL);
+}
+
+
 Sampler newBlockUsageSampler(GC_state s) {
   struct SamplerClosure func;
   func.fun = logCurrentBlockUsage;
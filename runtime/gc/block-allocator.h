@@ -169,13 +169,47 @@ typedef struct BlockAllocator {
   struct MegaBlockList *megaBlockSizeClass;
   pthread_mutex_t megaBlockLock;
 
+  /** Only used in the global allocator. An enum HeapPressure, refreshed
+    * periodically by the heap pressure sampler.
+    */
+  volatile uint32_t heapPressure;
+
 } *BlockAllocator;
 
 
+/** How close the heap is to @mpl max-heap. Each level adds a response on top
+  * of the previous ones:
+  *   COLLECT:  local collections trigger after a quarter of the usual
+  *             minCollectionSize has been allocated, and claim as many
+  *             levels as possible
+  *   CC:       concurrent collections are started at every eligible fork
+  *   THROTTLE: processors that run out of allocation space back off briefly
+  *             before continuing
+  * At the limit itself, allocation waits (a bounded number of times, with
+  * backoff) for other processors to free memory, and the program dies if
+  * none becomes available.
+  *
+  * The level is computed from the blocks in use, which collections bring
+  * down. The limit applies to blocks mapped, which stay mapped for reuse
+  * once freed. So when no more superblocks may be mapped, the level is at
+  * least CC regardless of how many blocks are in use.
+  */
+enum HeapPressure {
+  HEAP_PRESSURE_NONE = 0,
+  HEAP_PRESSURE_COLLECT = 1,
+  HEAP_PRESSURE_CC = 2,
+  HEAP_PRESSURE_THROTTLE = 3
+};
+
+
 typedef struct Blocks {
   SuperBlock container;
   size_t numBlocks;
   enum BlockPurpose purpose;
+  /** TRUE if the blocks were freshly mmap'ed, in which case everything past
+    * this struct is still zero.
+    */
+  bool knownZero;
 } *Blocks;
 
 #else
@@ -219,6 +253,18 @@ void queryCurrentBlockUsage(
 
 Sampler newBlockUsageSampler(GC_state s);
 
+/** Samples block usage against controls->maxHeap and updates the global
+  * heap pressure level. Does nothing without a max-heap.
+  */
+Sampler newHeapPressureSampler(GC_state s);
+
+static inline enum HeapPressure currentHeapPressure(GC_state s);
+
+/** Called on the slow path of allocation. Sleeps briefly under
+  * HEAP_PRESSURE_THROTTLE.
+  */
+void throttleUnderHeapPressure(GC_state s);
+
 #endif
 
 #endif // BLOCK_ALLOCATOR_H_
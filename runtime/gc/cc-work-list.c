@@ -336,4 +336,26 @@ objptr* CC_workList_pop(
   return r.field;
 }
 
+
+objptr* CC_workList_popPrefetched(
+  GC_state s,
+  CC_workList w,
+  PrefetchQueue q)
+{
+  struct PrefetchQueue_elem next;
+
+  objptr* current = CC_workList_pop(s, w);
+  while (NULL != current) {
+    if (PrefetchQueue_push(q, current, BOGUS_OBJPTR, &next))
+      return next.opp;
+    current = CC_workList_pop(s, w);
+  }
+
+  /* work list is empty; drain the fields still in flight */
+  if (PrefetchQueue_pop(q, &next))
+    return next.opp;
+
+  return NULL;
+}
+
 #endif /* MLTON_GC_INTERNAL_FUNCS */
@@ -51,6 +51,12 @@ void CC_workList_push(GC_state s, CC_workList w, objptr op);
   * Returns NULL if work list is empty */
 objptr* CC_workList_pop(GC_state s, CC_workList w);
 
+/** Like CC_workList_pop, but fields pass through the prefetch queue q
+  * (see prefetch-queue.h) before being returned. Returns NULL only when both
+  * the work list and q are empty.
+  */
+objptr* CC_workList_popPrefetched(GC_state s, CC_workList w, PrefetchQueue q);
+
 void CC_workList_free(GC_state s, CC_workList w);
 
 #endif /* MLTON_GC_INTERNAL_FUNCS */
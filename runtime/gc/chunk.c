@@ -81,8 +81,6 @@ void HM_appendChunk(HM_chunkList list, HM_chunk chunk) {
   list->lastChunk = chunk;
   list->size += HM_getChunkSize(chunk);
   list->usedSize += HM_getChunkUsedSize(chunk);
-
-  HM_computeFragmentation(list);
 }
 
 
@@ -108,6 +106,7 @@ HM_chunk HM_initializeChunk(pointer start, pointer end) {
   chunk->startGap = 0;
   chunk->pinnedDuringCollection = FALSE;
   chunk->mightContainMultipleObjects = TRUE;
+  chunk->knownZero = FALSE;
   chunk->tmpHeap = NULL;
   chunk->decheckState = DECHECK_BOGUS_TID;
   chunk->retireChunk = FALSE;
@@ -129,10 +128,12 @@ HM_chunk HM_getFreeChunkWithPurpose(GC_state s, size_t bytesRequested, enum Bloc
   Blocks start = allocateBlocksWithPurpose(s, numBlocks, purpose);
   SuperBlock container = start->container;
   numBlocks = start->numBlocks;
+  bool knownZero = start->knownZero;
   HM_chunk result =
     HM_initializeChunk((pointer)start, (pointer)start + chunkWidth);
   result->container = container;
   result->numBlocks = numBlocks;
+  result->knownZero = knownZero;
   return result;
 }
 
@@ -319,6 +320,48 @@ void HM_unlinkChunkPreserveLevelHead(HM_chunkList list, HM_chunk chunk) {
 }
 
 
+struct forwardThroughQueueArgs {
+  struct PrefetchQueue queue;
+  GC_foreachObjptrFun forward;
+  struct ForwardHHObjptrArgs* forwardArgs;
+};
+
+/* Forward a field that has come out of the prefetch queue. The object that
+ * contained the field is restored first, since the forwarding function may
+ * consult it. */
+static void forwardQueuedObjptr(
+  GC_state s,
+  struct forwardThroughQueueArgs* args,
+  struct PrefetchQueue_elem* elem)
+{
+  objptr containingObject = args->forwardArgs->containingObject;
+  args->forwardArgs->containingObject = elem->context;
+
+  objptr op = *(elem->opp);
+  if (isObjptr(op))
+    args->forward(s, elem->opp, op, args->forwardArgs);
+
+  args->forwardArgs->containingObject = containingObject;
+}
+
+static void forwardThroughQueue(
+  GC_state s,
+  objptr* opp,
+  __attribute__((unused)) objptr op,
+  void* rawArgs)
+{
+  struct forwardThroughQueueArgs* args = rawArgs;
+  struct PrefetchQueue_elem next;
+
+  if (PrefetchQueue_push(&(args->queue),
+                         opp,
+                         args->forwardArgs->containingObject,
+                         &next))
+  {
+    forwardQueuedObjptr(s, args, &next);
+  }
+}
+
 void HM_forwardHHObjptrsInChunkList(
   GC_state s,
   HM_chunk chunk,
@@ -335,15 +378,29 @@ void HM_forwardHHObjptrsInChunkList(
 
   pointer p = start;
 
+  struct forwardThroughQueueArgs queueArgs =
+    {.forward = forwardHHObjptrFunc, .forwardArgs = forwardHHObjptrArgs};
+  PrefetchQueue_init(&(queueArgs.queue), s->controls->gcPrefetchDepth);
+
   struct GC_foreachObjptrClosure forwardHHObjptrClosure =
-    {.fun = forwardHHObjptrFunc, .env = forwardHHObjptrArgs};
+    {.fun = forwardThroughQueue, .env = &queueArgs};
   struct GC_objptrPredicateClosure predicateClosure =
     {.fun = predicate, .env = predicateArgs};
 
   while (NULL != chunk) {
 
-    /* Can I use foreachObjptrInRange() for this? */
-    while (p != chunk->frontier) {
+    /* Can I use foreachObjptrInRange() for this?
+     *
+     * Forwarding a queued field may copy another object into this chunk, so
+     * the queue must be drained before moving past the frontier. */
+    while (p != chunk->frontier || !PrefetchQueue_isEmpty(&(queueArgs.queue))) {
+      if (p == chunk->frontier) {
+        struct PrefetchQueue_elem next;
+        PrefetchQueue_pop(&(queueArgs.queue), &next);
+        forwardQueuedObjptr(s, &queueArgs, &next);
+        continue;
+      }
+
       assert(p < chunk->frontier);
       p = advanceToObjectData(s, p);
 
@@ -667,30 +724,9 @@ bool listContainsChunk(HM_chunkList list, HM_chunk theChunk)
   return FALSE;
 }
 
-void HM_computeFragmentation(HM_chunkList list) {
-  if (list->usedSize == 0) {
-    printf("no chunks in list\n");
-  } else {
-   double fragmentation = (double)(list->size - list->usedSize) / (double)list->size;
-    printf("Fragmentation: %.2f\n", fragmentation);
-  }
-  HM_chunk chunk = list->firstChunk;
-  size_t total_size = 0;
-  size_t total_in_use = 0;
-  while (chunk != NULL) {
-   size_t in_use = HM_getChunkUsedSize(chunk);
-   size_t total = HM_getChunkSize(chunk);
-    total_size += total;
-    total_in_use += in_use;
-    HM_chunk next = chunk->nextChunk;
-    chunk = next;
-  }
-
-  if (total_size == 0) {
-    printf("chunk list has no chunks\n");
-  } else {
-    double fragmentation = (double)(total_size - total_in_use) / (double)total_size;
-    printf("Total fragmentation: %.2f\n", fragmentation);
-  }
+double HM_computeFragmentation(HM_chunkList list) {
+  if (0 == list->size)
+    return 0.0;
+  return (double)(list->size - list->usedSize) / (double)list->size;
 }
 
@@ -72,6 +72,12 @@ struct HM_chunk {
   bool retireChunk;
 
   bool mightContainMultipleObjects;
+
+  /* TRUE if the chunk was built from freshly mapped blocks, i.e. everything
+   * past the frontier is zero. Only allocateLargeSequence looks at this, and
+   * it clears the flag once it has placed its sequence. */
+  bool knownZero;
+
   void* tmpHeap;
 
   SuperBlock container;
@@ -181,7 +187,9 @@ void HM_prependChunk(HM_chunkList list, HM_chunk chunk);
 void HM_unlinkChunk(HM_chunkList list, HM_chunk chunk);
 void HM_unlinkChunkPreserveLevelHead(HM_chunkList list, HM_chunk chunk);
 
-void HM_computeFragmentation(HM_chunkList list);
+/* The fraction of the list's chunk space past the frontiers,
+ * i.e. (size-usedSize)/size, or 0 for an empty list. */
+double HM_computeFragmentation(HM_chunkList list);
 
 /**
  * Calls foreachHHObjptrInObject() on every object starting at 'start', which
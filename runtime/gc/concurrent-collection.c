@@ -36,6 +36,11 @@ void GC_updateObjectHeader(
 
 // void forwardPtrChunk (GC_state s, objptr *opp, void* rawArgs);
 void saveChunk(HM_chunk chunk, ConcurrentCollectArgs* args);
+void countLiveLines(
+  GC_state s,
+  HM_chunkList list,
+  size_t *numLines,
+  size_t *numLiveLines);
 
 #define ASSERT2 0
 
@@ -354,16 +359,67 @@ void tryUnmarkAndAddToWorkList(
   }
 }
 
+/* Count the lines (of CC_LINE_SIZE bytes, from each chunk's start to its
+ * frontier) of the retained chunks, and how many of them overlap a marked
+ * object. Objects are visited in address order, so a line is counted as
+ * live at most once without keeping a bitmap. Chunks holding a single
+ * object are skipped: they are retained exactly when that object is live. */
+void countLiveLines(
+  GC_state s,
+  HM_chunkList list,
+  size_t *numLines,
+  size_t *numLiveLines)
+{
+  *numLines = 0;
+  *numLiveLines = 0;
+
+  for (HM_chunk chunk = HM_getChunkListFirstChunk(list);
+       NULL != chunk;
+       chunk = chunk->nextChunk)
+  {
+    if (!chunk->mightContainMultipleObjects)
+      continue;
+
+    pointer base = (pointer)chunk;
+    pointer cursor = HM_getChunkStart(chunk);
+    pointer frontier = HM_getChunkFrontier(chunk);
+    if (cursor >= frontier)
+      continue;
+
+    size_t firstLine = (size_t)(cursor - base) / CC_LINE_SIZE;
+    size_t endLine = ((size_t)(frontier - base) + CC_LINE_SIZE - 1) / CC_LINE_SIZE;
+    *numLines += endLine - firstLine;
+
+    /* one past the last line already counted as live */
+    size_t liveEnd = firstLine;
+    while (cursor < frontier) {
+      pointer p = advanceToObjectData(s, cursor);
+      pointer end = p + sizeofObjectNoMetaData(s, p);
+      if (CC_isPointerMarked(p)) {
+        size_t lo = max((size_t)(cursor - base) / CC_LINE_SIZE, liveEnd);
+        size_t hi = ((size_t)(end - base) + CC_LINE_SIZE - 1) / CC_LINE_SIZE;
+        if (hi > lo) {
+          *numLiveLines += hi - lo;
+          liveEnd = hi;
+        }
+      }
+      cursor = end;
+    }
+  }
+}
+
 void markLoop(GC_state s, ConcurrentCollectArgs* args) {
   struct GC_foreachObjptrClosure markAddClosure =
     {.fun = tryMarkAndAddToWorkList, .env = (void*)args};
 
   CC_workList worklist = &(args->worklist);
+  struct PrefetchQueue queue;
+  PrefetchQueue_init(&queue, s->controls->gcPrefetchDepth);
 
-  objptr* current = CC_workList_pop(s, worklist);
+  objptr* current = CC_workList_popPrefetched(s, worklist, &queue);
   while (NULL != current) {
     callIfIsObjptr(s, &markAddClosure, current);
-    current = CC_workList_pop(s, worklist);
+    current = CC_workList_popPrefetched(s, worklist, &queue);
   }
 
   assert(CC_workList_isEmpty(s, worklist));
@@ -374,11 +430,13 @@ void unmarkLoop(GC_state s, ConcurrentCollectArgs* args) {
     {.fun = tryUnmarkAndAddToWorkList, .env = (void*)args};
 
   CC_workList worklist = &(args->worklist);
+  struct PrefetchQueue queue;
+  PrefetchQueue_init(&queue, s->controls->gcPrefetchDepth);
 
-  objptr* current = CC_workList_pop(s, worklist);
+  objptr* current = CC_workList_popPrefetched(s, worklist, &queue);
   while (NULL != current) {
     callIfIsObjptr(s, &unmarkAddClosure, current);
-    current = CC_workList_pop(s, worklist);
+    current = CC_workList_popPrefetched(s, worklist, &queue);
   }
 
   assert(CC_workList_isEmpty(s, worklist));
@@ -935,7 +993,7 @@ void CC_collectWithRoots(
   struct timespec startTime;
   struct timespec stopTime;
 
-  Trace0(EVENT_CGC_ENTER);
+  traceLongEnter(s, &(s->traceSample.cgcStart), EVENT_CGC_ENTER);
   timespec_now(&startTime);
 
   LOG(LM_CC_COLLECTION, LL_INFO,
@@ -1045,6 +1103,16 @@ void CC_collectWithRoots(
   assert(CC_workList_isEmpty(s, &(lists.worklist)));
   assert(NULL == tempRemovedFromCCBag->firstChunk);
 
+  /* Marking is complete, so the marks identify exactly the live objects of
+   * the retained chunks until the unmarking below. */
+  if (s->controls->ccLineStats) {
+    size_t numLines;
+    size_t numLiveLines;
+    countLiveLines(s, repList, &numLines, &numLiveLines);
+    s->cumulativeStatistics->numCCLines += numLines;
+    s->cumulativeStatistics->numCCLiveLines += numLiveLines;
+  }
+
   // saveNoForward(s, (void*)(thread->stack), &lists);
   // saveNoForward(s, (void*)thread, &lists);
 
@@ -1178,6 +1246,14 @@ void CC_collectWithRoots(
   // HM_appendChunkList(repList, origList);
   *(origList) = *(repList);
 
+  /* Retained chunks hold dead objects alongside the marked ones. They can't
+   * be reclaimed here without moving live objects, so leave that to a local
+   * collection once this level is private again (see sparseLevelToCompact).
+   * Measured before the stack chunks are unlinked below, so that retained
+   * and marked bytes (lists.bytesSaved) cover the same chunks. */
+  size_t bytesRetained = HM_getChunkListUsedSize(origList);
+  size_t bytesSparse = bytesRetained - min(bytesRetained, lists.bytesSaved);
+
   HM_chunk stackChunk = HM_getChunkOf(objptrToPointer(cp->stack, NULL));
   assert(!(stackChunk->mightContainMultipleObjects));
   assert(HM_HH_getChunkList(HM_getLevelHead(stackChunk)) == origList);
@@ -1203,6 +1279,10 @@ void CC_collectWithRoots(
     cp->additionalStack = BOGUS_OBJPTR;
   }
 
+  cp->bytesSparse = bytesSparse;
+  s->cumulativeStatistics->bytesRetainedByCC += bytesRetained;
+  s->cumulativeStatistics->bytesSparseAfterCC += bytesSparse;
+
 // #if ASSERT
 //   struct HM_foreachDownptrClosure checkRemEntryClosure =
 //     {.fun = checkRemEntry, .env = &lists};
@@ -1235,7 +1315,8 @@ void CC_collectWithRoots(
     *outputNumObjectsMarked = lists.numObjectsMarked;
   }
 
-  Trace0(EVENT_CGC_LEAVE);
+  if (traceLongLeave(s, s->traceSample.cgcStart, EVENT_CGC_ENTER, EVENT_CGC_LEAVE))
+    traceHeapOccupancy(s);
   
   return;
 }
@@ -59,6 +59,11 @@ typedef struct ConcurrentPackage {
   size_t bytesAllocatedSinceLastCollection;
   size_t bytesSurvivedLastCollection;
 
+  /** Dead bytes that CC left behind in the chunks it retained, because
+    * those chunks also held live objects. See sparseLevelToCompact.
+    */
+  size_t bytesSparse;
+
   /** To avoid races with other processor adding to the remset (writebarrier or
     * promotions).
     */
@@ -84,6 +89,9 @@ PRIVATE void GC_updateObjectHeader(GC_state s, pointer p, GC_header newHeader);
 
 #if (defined (MLTON_GC_INTERNAL_FUNCS))
 
+/* Granularity at which CC measures occupancy of the chunks it retains. */
+#define CC_LINE_SIZE 256
+
 // Assume complete access in this function
 // This function constructs a HM_chunkList of reachable chunks without copying them
 // Then it adds the remaining chunks to the free list.
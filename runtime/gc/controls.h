@@ -31,11 +31,21 @@ struct HM_HierarchicalHeapConfig {
    * local collection */
   size_t minCollectionSize;
 
+  /* if nonzero, the longest local collection pause (in microseconds) to aim
+   * for. See HM_HH_desiredCollectionScope. */
+  uint32_t lgcPauseTargetUs;
+
   /* smallest amount for a CC */
   size_t minCCSize;
 
   size_t maxCCChainLength;
   double ccThresholdRatio;
+
+  /* if nonzero, a level whose dead bytes (left behind by CC in chunks it
+   * had to retain) are at least this fraction of its used bytes is
+   * evacuated by the next local collection that can reach it. See
+   * sparseLevelToCompact. 0 (the default) disables this. */
+  double ccCompactThreshold;
   uint32_t maxCCDepth;
 
   /* the shallowest depth that will be claimed for a local
@@ -60,6 +70,9 @@ struct GC_controls {
   bool mayProcessAtMLton;
   bool messages; /* Print a message at the start and end of each gc. */
   bool heartbeatStats;
+  /* Count the live lines of chunks retained by CC, which costs an extra
+   * walk over those chunks per CC, see countLiveLines. */
+  bool ccLineStats;
   int heartbeatMicroseconds;
   uint32_t heartbeatTokens; /* number of tokens generated per heartbeat */
   int heartbeatRelayerThreshold;
@@ -83,8 +96,32 @@ struct GC_controls {
   enum SummaryFormat summaryFormat;
   FILE* summaryFile;
   enum GC_CollectionType collectionType;
-  /* Size of the trace buffer */
+  /* Size of each of the two trace buffers, in events */
   size_t traceBufferSize;
+  /* When the runtime is built without ENABLE_TRACING, trace LGCs and CGCs
+   * that take at least traceSampleThreshold, plus one in every
+   * traceSampleRate scheduler events. 0 disables tracing. */
+  uint32_t traceSampleRate;
+  struct timespec traceSampleThreshold;
+  /* If non-NULL, serve live metrics on a Unix domain socket at this path. */
+  const char *metricsSocket;
+  /* If nonzero, the most memory the block allocator may map, in bytes.
+   * See enum HeapPressure. */
+  size_t maxHeap;
+  /* Maximum number of bytes of recycled stack chunks cached per processor,
+   * see recycleThreadStack. 0 disables the pool. */
+  size_t threadStackPoolSize;
+  /* Number of fields the tracing loops keep in flight while the objects
+   * they point to are prefetched, see prefetch-queue.h. 0 disables
+   * prefetching. At most PREFETCH_QUEUE_MAX_DEPTH. */
+  uint32_t gcPrefetchDepth;
+  /* Sequences without objptrs of at least this many bytes are copied by
+   * the local GC with non-temporal stores, see GC_memcpyNonTemporal.
+   * 0 disables non-temporal copies. */
+  size_t nonTemporalCopyMinBytes;
+  /* Number of helper threads serving MPLFile.Async batches, started on
+   * first use, see async-io.h. */
+  uint32_t aioThreads;
 };
 
 #endif /* (defined (MLTON_GC_INTERNAL_TYPES)) */
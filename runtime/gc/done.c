@@ -134,6 +134,8 @@ static void displayCumulativeStatistics (FILE *out, struct GC_cumulativeStatisti
            uintmaxToCommaString (cumulativeStatistics->bytesAllocated));
   fprintf (out, "total bytes promoted: %s bytes\n",
            uintmaxToCommaString (cumulativeStatistics->bytesPromoted));
+  fprintf (out, "total bytes pinned by down-pointers: %s bytes\n",
+           uintmaxToCommaString (cumulativeStatistics->bytesPinnedDown));
   fprintf (out, "max global heap bytes live: %s bytes\n",
            uintmaxToCommaString (cumulativeStatistics->maxBytesLive));
   fprintf (out, "max global heap size: %s bytes\n",
@@ -150,6 +152,55 @@ static void displayCumulativeStatistics (FILE *out, struct GC_cumulativeStatisti
            uintmaxToCommaString (cumulativeStatistics->bytesScannedMinor));
   fprintf (out, "bytes hash consed: %s bytes\n",
            uintmaxToCommaString (cumulativeStatistics->bytesHashConsed));
+  {
+    uintmax_t hits = cumulativeStatistics->numThreadStackPoolHits;
+    uintmax_t total = hits + cumulativeStatistics->numThreadStackPoolMisses;
+    fprintf (out, "thread stack pool hits: %s of %s (%.1f%%)\n",
+             uintmaxToCommaString (hits),
+             uintmaxToCommaString (total),
+             (0 == total) ? 0.0 : 100.0 * ((double) hits) / (double) total);
+  }
+  fprintf (out, "heap pressure throttles: %s\n",
+           uintmaxToCommaString (cumulativeStatistics->numHeapThrottles));
+  fprintf (out, "heap limit waits: %s\n",
+           uintmaxToCommaString (cumulativeStatistics->numHeapLimitWaits));
+  {
+    TimeHistogram h = cumulativeStatistics->localGCPauses;
+    struct timespec *m = &(cumulativeStatistics->maxLocalGCPause);
+    fprintf (out, "local GC pauses: p50 %s us, p90 %s us, p99 %s us, max %s us\n",
+             uintmaxToCommaString (TimeHistogram_percentileUs (h, 0.5)),
+             uintmaxToCommaString (TimeHistogram_percentileUs (h, 0.9)),
+             uintmaxToCommaString (TimeHistogram_percentileUs (h, 0.99)),
+             uintmaxToCommaString ((uintmax_t)m->tv_sec * 1000000
+                                   + (uintmax_t)m->tv_nsec / 1000));
+  }
+  {
+    uintmax_t retained = cumulativeStatistics->bytesRetainedByCC;
+    uintmax_t sparse = cumulativeStatistics->bytesSparseAfterCC;
+    fprintf (out, "CC retained chunks: %s bytes (%.1f%% dead)\n",
+             uintmaxToCommaString (retained),
+             (0 == retained) ? 0.0 : 100.0 * ((double) sparse) / (double) retained);
+    uintmax_t lines = cumulativeStatistics->numCCLines;
+    uintmax_t liveLines = cumulativeStatistics->numCCLiveLines;
+    /* only counted with @mpl cc-line-stats */
+    if (0 != lines)
+      fprintf (out, "CC line occupancy: %s of %s lines live (%.1f%%)\n",
+               uintmaxToCommaString (liveLines),
+               uintmaxToCommaString (lines),
+               100.0 * ((double) liveLines) / (double) lines);
+    fprintf (out, "compacting local GCs: %s, %s bytes -> %s bytes\n",
+             uintmaxToCommaString (cumulativeStatistics->numCompactingLocalGCs),
+             uintmaxToCommaString (cumulativeStatistics->bytesCompactedFrom),
+             uintmaxToCommaString (cumulativeStatistics->bytesCompactedTo));
+  }
+  {
+    double secs =
+      (double)cumulativeStatistics->timeLocalGC.tv_sec
+      + (double)cumulativeStatistics->timeLocalGC.tv_nsec / 1000000000.0;
+    fprintf (out, "bytes copied / local GC time: %.2f GB/s\n",
+             (0.0 == secs) ? 0.0 :
+             (double)cumulativeStatistics->bytesHHLocaled / secs / 1e9);
+  }
   fprintf (out, "sync for old gen array: %s\n",
            uintmaxToCommaString (cumulativeStatistics->syncForOldGenArray));
   fprintf (out, "sync for new gen array: %s\n",
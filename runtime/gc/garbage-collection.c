@@ -53,13 +53,17 @@ void growStackCurrent(GC_state s) {
   HM_HierarchicalHeap newhh =
     HM_HH_getHeapAtDepth(s, getThreadCurrent(s), HM_HH_getDepth(hh));
 
-  /* in this case, the new stack needs more space, so allocate a new chunk,
-   * copy the stack, and throw away the old chunk. */
-  HM_chunk newChunk = HM_allocateChunkWithPurpose(
-    HM_HH_getChunkList(newhh),
-    stackSize,
-    BLOCK_FOR_HEAP_CHUNK);
-    
+  /* in this case, the new stack needs more space, so move it to a new chunk,
+   * preferring one cached in the processor's stack pool. */
+  HM_chunk newChunk =
+    takeThreadStackChunk(s, HM_HH_getChunkList(newhh), stackSize);
+  if (NULL == newChunk) {
+    newChunk = HM_allocateChunkWithPurpose(
+      HM_HH_getChunkList(newhh),
+      stackSize,
+      BLOCK_FOR_HEAP_CHUNK);
+  }
+
   if (NULL == newChunk) {
     DIE("Ran out of space to grow stack!");
   }
@@ -71,6 +75,18 @@ void growStackCurrent(GC_state s) {
   pointer frontier = HM_getChunkFrontier(newChunk);
   assert(frontier == HM_getChunkStart(newChunk));
   assert(GC_STACK_METADATA_SIZE == GC_HEADER_SIZE);
+
+  /* The chunk is block-aligned, so usually there is room past stackSize.
+   * Claim all of it: deep recursions then take fewer copies to reach their
+   * final depth. */
+  size_t capacity = (size_t)(HM_getChunkLimit(newChunk) - frontier);
+  size_t fill = capacity - GC_STACK_METADATA_SIZE - sizeof(struct GC_stack);
+  if (fill > reserved && isAligned(capacity, s->alignment)) {
+    reserved = fill;
+    stackSize = sizeofStackWithMetaData(s, reserved);
+    if (reserved > s->cumulativeStatistics->maxStackSize)
+      s->cumulativeStatistics->maxStackSize = reserved;
+  }
   *((GC_header*)frontier) = GC_STACK_HEADER;
   stack = (GC_stack)(frontier + GC_HEADER_SIZE);
   stack->reserved = reserved;
@@ -84,13 +100,27 @@ void growStackCurrent(GC_state s) {
   getThreadCurrent(s)->stack = pointerToObjptr((pointer)stack, NULL);
 
   assert(getThreadCurrent(s)->currentChunk != chunk);
-  // HM_unlinkChunk(HM_HH_getChunkList(hh), chunk);
-  // HM_freeChunk(s, chunk);
+
+  /* The old stack is now garbage. When it lives in the thread's own leaf
+   * heap, no other processor or collection can be looking at it, so its
+   * chunk can be reused right away instead of waiting for a local
+   * collection. */
+  if (hh == getThreadCurrent(s)->hierarchicalHeap &&
+      HM_HH_getConcurrentPack(hh)->ccstate == CC_UNREG &&
+      !chunk->pinnedDuringCollection &&
+      !chunk->retireChunk &&
+      threadStackPoolHasRoom(s, chunk))
+  {
+    poolStackChunk(s, hh, chunk);
+  }
 }
 
 void GC_collect (GC_state s, size_t bytesRequested, bool force) {
   enter(s);
   maybeSample(s, s->blockUsageSampler);
+  throttleUnderHeapPressure(s);
+  if (currentHeapPressure(s) >= HEAP_PRESSURE_COLLECT)
+    releaseThreadStackPool(s);
 
   // HM_HierarchicalHeap h = getThreadCurrent(s)->hierarchicalHeap;
   // while (h->nextAncestor != NULL) h = h->nextAncestor;
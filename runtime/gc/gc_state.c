@@ -335,6 +335,22 @@ uintmax_t GC_maxStackSizeForHeartbeat(GC_state s) {
   return count;
 }
 
+uintmax_t GC_threadStackPoolHits(GC_state s) {
+  uintmax_t count = 0;
+  for (uint32_t p = 0; p < s->numberOfProcs; p++) {
+    count += s->procStates[p].cumulativeStatistics->numThreadStackPoolHits;
+  }
+  return count;
+}
+
+uintmax_t GC_threadStackPoolMisses(GC_state s) {
+  uintmax_t count = 0;
+  for (uint32_t p = 0; p < s->numberOfProcs; p++) {
+    count += s->procStates[p].cumulativeStatistics->numThreadStackPoolMisses;
+  }
+  return count;
+}
+
 __attribute__((noreturn))
 void GC_setHashConsDuringGC(__attribute__((unused)) GC_state s, __attribute__((unused)) Bool_t b) {
   DIE("GC_setHashConsDuringGC unsupported");
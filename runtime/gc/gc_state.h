@@ -34,6 +34,7 @@ struct GC_state {
   struct BlockAllocator *blockAllocatorGlobal;
   struct BlockAllocator *blockAllocatorLocal;
   struct Sampler *blockUsageSampler;
+  struct Sampler *heapPressureSampler;
   objptr callFromCHandlerThread; /* Handler for exported C calls (in heap). */
   pointer callFromCOpArgsResPtr; /* Pass op, args, and res from exported C call */
   struct GC_controls *controls;
@@ -98,9 +99,14 @@ struct GC_state {
                                 * 1: okay to terminate
                                 * 0: ready to terminate
                                 */
+  struct HM_chunkList threadStackPool; /* Recycled stack chunks; see thread.c */
+  double localGCBytesPerUs; /* Learned local collection throughput, in bytes
+                             * in scope per microsecond; 0 until the first
+                             * collection. See hierarchical-heap.c */
   GC_weak weaks; /* Linked list of (live) weak pointers */
   char *worldFile;
   struct TracingContext *trace;
+  struct TracingSampleState traceSample;
   struct TLSObjects tlsObjects;
 };
 
@@ -164,6 +170,9 @@ PRIVATE uint32_t GC_getControlMaxCCDepth(GC_state s);
 PRIVATE uintmax_t GC_maxStackFramesWalkedForHeartbeat(GC_state s);
 PRIVATE uintmax_t GC_maxStackSizeForHeartbeat(GC_state s);
 
+PRIVATE uintmax_t GC_threadStackPoolHits(GC_state s);
+PRIVATE uintmax_t GC_threadStackPoolMisses(GC_state s);
+
 PRIVATE uint32_t GC_getHeartbeatMicroseconds(GC_state s);
 PRIVATE uint32_t GC_getHeartbeatTokens(GC_state s);
 PRIVATE uint32_t GC_getHeartbeatRelayerThreshold(GC_state s);
@@ -97,6 +97,7 @@ GC_objectTypeTag computeObjectCopyParameters(GC_state s, GC_header header,
 pointer copyObject(pointer p,
                    size_t objectSize,
                    size_t copySize,
+                   bool nonTemporal,
                    HM_HierarchicalHeap tgtHeap);
 
 void delLastObj(objptr op, size_t objectSize, HM_HierarchicalHeap tgtHeap);
@@ -205,6 +206,8 @@ void HM_HHC_collectLocal(uint32_t desiredScope)
     return;
   }
 
+  releaseThreadStackPool(s);
+
   // if (NULL != hh->subHeapForCC) {
   //   LOG(LM_HH_COLLECTION, LL_INFO,
   //     "Skipping local collection at depth %u due to outstanding CC",
@@ -281,10 +284,13 @@ void HM_HHC_collectLocal(uint32_t desiredScope)
   LOG(LM_HH_COLLECTION, LL_DEBUG,
       "START");
 
-  Trace0(EVENT_LGC_ENTER);
+  traceLongEnter(s, &(s->traceSample.lgcStart), EVENT_LGC_ENTER);
 
   s->cumulativeStatistics->numHHLocalGCs++;
 
+  struct timespec pauseStart;
+  timespec_now(&pauseStart);
+
   /* used needs to be set because the mutator has changed s->stackTop. */
   getStackCurrent(s)->used = sizeofGCStateCurrentStackUsed(s);
   getThreadCurrent(s)->exnStack = s->exnStack;
@@ -377,6 +383,8 @@ void HM_HHC_collectLocal(uint32_t desiredScope)
   for (uint32_t i = 0; i <= maxDepth; i++)
     sizesBefore[i] = 0;
   size_t totalSizeBefore = 0;
+  size_t scopeSizeBefore = 0;
+  size_t sparseInScope = 0;
   for (HM_HierarchicalHeap cursor = hh;
        NULL != cursor;
        cursor = cursor->nextAncestor)
@@ -389,6 +397,10 @@ void HM_HHC_collectLocal(uint32_t desiredScope)
     size_t sz = HM_getChunkListUsedSize(HM_HH_getChunkList(cursor));
     sizesBefore[d] = sz;
     totalSizeBefore += sz;
+    if (d >= minDepth) {
+      scopeSizeBefore += HM_getChunkListSize(HM_HH_getChunkList(cursor));
+      sparseInScope += HM_HH_getConcurrentPack(cursor)->bytesSparse;
+    }
   }
 
   /* ===================================================================== */
@@ -919,6 +931,7 @@ void HM_HHC_collectLocal(uint32_t desiredScope)
 
   // sizes info and stats
   size_t totalSizeAfter = 0;
+  size_t scopeSizeAfter = 0;
 
   for (HM_HierarchicalHeap cursor = hh;
        NULL != cursor;
@@ -929,6 +942,8 @@ void HM_HHC_collectLocal(uint32_t desiredScope)
     HM_chunkList lev = HM_HH_getChunkList(cursor);
     size_t sizeAfter = HM_getChunkListUsedSize(lev);
     totalSizeAfter += sizeAfter;
+    if (i >= minDepth)
+      scopeSizeAfter += HM_getChunkListSize(lev);
 
 #if ASSERT
     HM_assertChunkListInvariants(lev);
@@ -966,6 +981,13 @@ void HM_HHC_collectLocal(uint32_t desiredScope)
 
   s->cumulativeStatistics->bytesInScopeForLocal += totalSizeBefore;
 
+  if (sparseInScope > 0)
+  {
+    s->cumulativeStatistics->numCompactingLocalGCs++;
+    s->cumulativeStatistics->bytesCompactedFrom += scopeSizeBefore;
+    s->cumulativeStatistics->bytesCompactedTo += scopeSizeAfter;
+  }
+
   if (totalSizeAfter > totalSizeBefore)
   {
     // whoops?
@@ -1004,7 +1026,15 @@ void HM_HHC_collectLocal(uint32_t desiredScope)
     stopTiming(RUSAGE_THREAD, &ru_start, &s->cumulativeStatistics->ru_gc);
   }
 
-  Trace0(EVENT_LGC_LEAVE);
+  /* Measured in the same units that HM_HH_desiredCollectionScope budgets
+   * in, so that the learned throughput can be applied directly. */
+  struct timespec pause;
+  timespec_now(&pause);
+  timespec_sub(&pause, &pauseStart);
+  HM_HH_recordLocalCollection(s, scopeSizeBefore, &pause);
+
+  if (traceLongLeave(s, s->traceSample.lgcStart, EVENT_LGC_ENTER, EVENT_LGC_LEAVE))
+    traceHeapOccupancy(s);
 
   LOG(LM_HH_COLLECTION, LL_DEBUG,
       "END");
@@ -1083,10 +1113,21 @@ objptr relocateObject(
     return op;
   }
 
-  /* Otherwise try copying the object */
+  /* Otherwise try copying the object. Large sequences without objptrs are
+   * not read again by this collection, so don't pull them into the cache. */
+  GC_objectTypeTag tag;
+  uint16_t numObjptrs;
+  splitHeader(s, header, &tag, NULL, NULL, &numObjptrs);
+  bool nonTemporal =
+    (SEQUENCE_TAG == tag) &&
+    (0 == numObjptrs) &&
+    (0 != s->controls->nonTemporalCopyMinBytes) &&
+    (copyBytes >= s->controls->nonTemporalCopyMinBytes);
+
   pointer copyPointer = copyObject(p - metaDataBytes,
                                    objectBytes,
                                    copyBytes,
+                                   nonTemporal,
                                    tgtHeap);
 
   /* Store the forwarding pointer in the old object metadata. */
@@ -1314,11 +1355,14 @@ void phaseLoop(GC_state s, void *rawArgs, GC_foreachObjptrClosure fClosure)
   struct ForwardHHObjptrArgs *args = (struct ForwardHHObjptrArgs *)rawArgs;
 
   CC_workList worklist = &(args->worklist);
-  objptr *current = CC_workList_pop(s, worklist);
+  struct PrefetchQueue queue;
+  PrefetchQueue_init(&queue, s->controls->gcPrefetchDepth);
+
+  objptr *current = CC_workList_popPrefetched(s, worklist, &queue);
   while (NULL != current)
   {
     callIfIsObjptr(s, fClosure, current);
-    current = CC_workList_pop(s, worklist);
+    current = CC_workList_popPrefetched(s, worklist, &queue);
   }
   assert(CC_workList_isEmpty(s, worklist));
 }
@@ -1818,6 +1862,7 @@ void forwardHHObjptr(
 pointer copyObject(pointer p,
                    size_t objectSize,
                    size_t copySize,
+                   bool nonTemporal,
                    HM_HierarchicalHeap tgtHeap)
 {
 
@@ -1867,7 +1912,10 @@ pointer copyObject(pointer p,
 
   pointer frontier = HM_getChunkFrontier(chunk);
 
-  GC_memcpy(p, frontier, copySize);
+  if (nonTemporal)
+    GC_memcpyNonTemporal(p, frontier, copySize);
+  else
+    GC_memcpyObject(p, frontier, copySize);
   pointer newFrontier = frontier + objectSize;
   HM_updateChunkFrontierInList(tgtChunkList, chunk, newFrontier);
   // if (newFrontier >= (pointer)chunk + HM_BLOCK_SIZE) {
@@ -89,7 +89,10 @@ bool isObjptrInToSpace(objptr op, struct ForwardHHObjptrArgs *args);
 
 objptr relocateObject(GC_state s, objptr obj, HM_HierarchicalHeap tgtHeap, struct ForwardHHObjptrArgs *args, bool *relocSuccess);
 
-pointer copyObject(pointer p, size_t objectSize, size_t copySize, HM_HierarchicalHeap tgtHeap);
+/* Copy an object into tgtHeap. If nonTemporal, the copy bypasses the cache
+ * (see GC_memcpyNonTemporal); relocateObject asks for this for sequences
+ * without objptrs of at least @mpl gc-nontemporal-copy-min bytes. */
+pointer copyObject(pointer p, size_t objectSize, size_t copySize, bool nonTemporal, HM_HierarchicalHeap tgtHeap);
 #endif /* MLTON_GC_INTERNAL_FUNCS */
 
 #endif /* HIERARCHICAL_HEAP_H_ */
@@ -233,6 +233,8 @@ HM_HierarchicalHeap HM_HH_zip(
       // This has to happen before linkInto (which frees hh2)
       HM_HierarchicalHeap hh2anc = hh2->nextAncestor;
       CC_freeStack(s, HM_HH_getConcurrentPack(hh2));
+      HM_HH_getConcurrentPack(hh1)->bytesSparse +=
+        HM_HH_getConcurrentPack(hh2)->bytesSparse;
       linkCCChains(s, hh1, hh2);
       linkInto(s, hh1, hh2);
 
@@ -514,6 +516,7 @@ HM_HierarchicalHeap HM_HH_new(GC_state s, uint32_t depth)
   HM_HH_getConcurrentPack(hh)->ccstate = CC_UNREG;
   HM_HH_getConcurrentPack(hh)->bytesSurvivedLastCollection = 0;
   HM_HH_getConcurrentPack(hh)->bytesAllocatedSinceLastCollection = 0;
+  HM_HH_getConcurrentPack(hh)->bytesSparse = 0;
 
   // hh->representative = NULL;
   hh->ufNode = uf;
@@ -802,6 +805,8 @@ void mergeCompletedCCs(GC_state s, HM_HierarchicalHeap hh) {
       /* consider using max instead of addition */
       HM_HH_getConcurrentPack(hh)->bytesSurvivedLastCollection +=
         HM_HH_getConcurrentPack(completed)->bytesSurvivedLastCollection;
+      HM_HH_getConcurrentPack(hh)->bytesSparse +=
+        HM_HH_getConcurrentPack(completed)->bytesSparse;
       
       /*
       HM_HH_getConcurrentPack(hh)->bytesSurvivedLastCollection =
@@ -841,8 +846,11 @@ bool checkPolicyforRoot(
   HM_HierarchicalHeap hh = thread->hierarchicalHeap;
   assert(NULL != hh);
 
+  /* Near the max-heap, take every CC we are offered. */
+  bool pressured = currentHeapPressure(s) >= HEAP_PRESSURE_CC;
+
   if (HM_getChunkListSize(HM_HH_getChunkList(hh))
-      < s->controls->hhConfig.minCCSize)
+      < (pressured ? 1 : s->controls->hhConfig.minCCSize))
   {
     return FALSE;
   }
@@ -860,6 +868,9 @@ bool checkPolicyforRoot(
       return FALSE;
   }
 
+  if (pressured)
+    return TRUE;
+
   size_t bytesSurvived = HM_HH_getConcurrentPack(hh)->bytesSurvivedLastCollection;
   
   /* consider removing this: */
@@ -897,7 +908,7 @@ objptr copyCurrentStack(GC_state s, GC_thread thread) {
   // copyObject can add a chunk to the list. It updates the frontier but not the
   // thread current chunk. Also it returns the pointer to the header part.
   pointer stackCopy = copyObject(stackPtr - metaDataSize,
-                                 objectSize, copySize, hh);
+                                 objectSize, copySize, FALSE, hh);
   thread->currentChunk = HM_getChunkListLastChunk(HM_HH_getChunkList(hh));
   stackCopy += metaDataSize;
   ((GC_stack)stackCopy)->reserved = ((GC_stack)stackCopy)->used;
@@ -1158,9 +1169,50 @@ void HM_HH_updateValues(GC_thread thread, pointer frontier) {
     frontier);
 }
 
+/* The most data a local collection can have in scope and still meet the
+ * pause target, going by this processor's past collections. 0 if there is
+ * no target or nothing has been learned yet. */
+static size_t pauseTargetBytes(GC_state s) {
+  uint32_t target = s->controls->hhConfig.lgcPauseTargetUs;
+  if (0 == target || s->localGCBytesPerUs <= 0.0)
+    return 0;
+  return (size_t)(s->localGCBytesPerUs * (double)target);
+}
+
+void HM_HH_recordLocalCollection(
+  GC_state s,
+  size_t bytesInScope,
+  struct timespec *pause)
+{
+  TimeHistogram_insert(s->cumulativeStatistics->localGCPauses, pause);
+  if (timespec_geq(pause, &(s->cumulativeStatistics->maxLocalGCPause)))
+    s->cumulativeStatistics->maxLocalGCPause = *pause;
+
+  double us = (double)pause->tv_sec * 1e6 + (double)pause->tv_nsec / 1e3;
+  if (us < 1.0 || bytesInScope == 0)
+    return;
+
+  /* Exponential moving average, so that the estimate follows phase changes
+   * in the program without jumping around on a single outlier. */
+  double rate = (double)bytesInScope / us;
+  if (s->localGCBytesPerUs <= 0.0)
+    s->localGCBytesPerUs = rate;
+  else
+    s->localGCBytesPerUs = 0.75 * s->localGCBytesPerUs + 0.25 * rate;
+}
+
 size_t HM_HH_nextCollectionThreshold(GC_state s, size_t survivingSize) {
   size_t threshold =
     (size_t)((double)survivingSize * s->controls->hhConfig.collectionThresholdRatio);
+
+  /* Survivors of the last collection will be in scope again, so leave room
+   * for them under the pause budget. */
+  size_t pauseBytes = pauseTargetBytes(s);
+  if (pauseBytes > 0) {
+    size_t room = (pauseBytes > survivingSize) ? pauseBytes - survivingSize : 0;
+    threshold = min(threshold, room);
+  }
+
   if (threshold < s->controls->hhConfig.minCollectionSize) {
     threshold = s->controls->hhConfig.minCollectionSize;
   }
@@ -1172,6 +1224,55 @@ size_t HM_HH_addRecentBytesAllocated(GC_thread thread, size_t bytes) {
   return thread->bytesAllocatedSinceLastCollection;
 }
 
+/* The shallowest level that CC left sparse enough to be worth evacuating
+ * with a local collection (see ccCompactThreshold), or currentDepth+1 if
+ * there is none. Only levels that a local collection could claim right now
+ * are considered, so a compaction that is asked for is not refused. With a
+ * pause target, so are only scopes that fit in its budget.
+ *
+ * Levels shallower than minLocalCollectionDepth (by default, the root
+ * levels 0 and 1) are never claimed by a local collection, so whatever CC
+ * leaves sparse there stays until CC collects them again. */
+static uint32_t sparseLevelToCompact(
+  GC_state s,
+  GC_thread thread,
+  uint32_t potentialLocalScope)
+{
+  double threshold = s->controls->hhConfig.ccCompactThreshold;
+  uint32_t result = thread->currentDepth+1;
+  if (threshold <= 0.0 || SUPERLOCAL == s->controls->collectionType)
+    return result;
+
+  size_t pauseBytes = pauseTargetBytes(s);
+  size_t scopeSize = 0;
+  uint32_t minDepth = max(potentialLocalScope, thread->minLocalCollectionDepth);
+  for (HM_HierarchicalHeap cursor = thread->hierarchicalHeap;
+       NULL != cursor && HM_HH_getDepth(cursor) >= minDepth;
+       cursor = cursor->nextAncestor)
+  {
+    scopeSize += HM_getChunkListSize(HM_HH_getChunkList(cursor));
+    if (pauseBytes > 0 && scopeSize > pauseBytes)
+      break;
+
+    ConcurrentPackage cp = HM_HH_getConcurrentPack(cursor);
+    if (NULL != cursor->subHeapForCC ||
+        NULL != cursor->subHeapCompletedCC ||
+        CC_UNREG != cp->ccstate)
+    {
+      break;
+    }
+
+    size_t used = HM_getChunkListUsedSize(HM_HH_getChunkList(cursor));
+    if (used >= s->controls->hhConfig.minCollectionSize &&
+        (double)cp->bytesSparse >= threshold * (double)used)
+    {
+      result = HM_HH_getDepth(cursor);
+    }
+  }
+
+  return result;
+}
+
 uint32_t HM_HH_desiredCollectionScope(GC_state s, GC_thread thread)
 {
   struct HM_HierarchicalHeap* hh = thread->hierarchicalHeap;
@@ -1179,7 +1280,40 @@ uint32_t HM_HH_desiredCollectionScope(GC_state s, GC_thread thread)
   if (s->wsQueueTop == BOGUS_OBJPTR)
     return thread->currentDepth+1; /* don't collect */
 
-  if (thread->bytesAllocatedSinceLastCollection <
+  /* Near the max-heap, collect as many levels as we can once a quarter of
+   * the usual minimum collection size has been allocated. */
+  if (currentHeapPressure(s) >= HEAP_PRESSURE_COLLECT &&
+      4 * thread->bytesAllocatedSinceLastCollection >=
+        s->controls->hhConfig.minCollectionSize)
+  {
+    uint64_t topval = *(uint64_t*)objptrToPointer(s->wsQueueTop, NULL);
+    uint32_t potentialLocalScope = UNPACK_IDX(topval);
+    if (potentialLocalScope <= thread->currentDepth)
+      return potentialLocalScope;
+  }
+
+  /* A level left sparse by CC is evacuated regardless of allocation, as
+   * long as the scope fits in the pause budget. */
+  {
+    uint64_t topval = *(uint64_t*)objptrToPointer(s->wsQueueTop, NULL);
+    uint32_t compactScope =
+      sparseLevelToCompact(s, thread, UNPACK_IDX(topval));
+    if (compactScope <= thread->currentDepth)
+      return compactScope;
+  }
+
+  /* With a pause target, the trigger and the budget below are both capped
+   * by how much this processor can collect within the target. */
+  size_t pauseBytes = pauseTargetBytes(s);
+
+  if (pauseBytes > 0) {
+    if (thread->bytesAllocatedSinceLastCollection <
+        HM_HH_nextCollectionThreshold(s, thread->bytesSurvivedLastCollection))
+    {
+      return thread->currentDepth+1; /* don't collect */
+    }
+  }
+  else if (thread->bytesAllocatedSinceLastCollection <
       (s->controls->hhConfig.collectionThresholdRatio * thread->bytesSurvivedLastCollection))
   {
     return thread->currentDepth+1; /* don't collect */
@@ -1190,6 +1324,14 @@ uint32_t HM_HH_desiredCollectionScope(GC_state s, GC_thread thread)
 
   size_t budget = 4 * thread->bytesAllocatedSinceLastCollection;
 
+  /* The leaf alone may exceed the pause budget; it still has to be
+   * collected, so only cap the budget for ancestors beyond it. */
+  if (pauseBytes > 0) {
+    size_t floor = max(s->controls->hhConfig.minCollectionSize,
+                       HM_getChunkListSize(HM_HH_getChunkList(hh)) + 1);
+    budget = min(budget, max(pauseBytes, floor));
+  }
+
   if (budget < s->controls->hhConfig.minCollectionSize ||
       potentialLocalScope > thread->currentDepth ||
       potentialLocalScope > HM_HH_getDepth(hh) ||
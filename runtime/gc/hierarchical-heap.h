@@ -147,6 +147,10 @@ pointer HM_HH_getLimit(GC_thread thread);
 void HM_HH_updateValues(GC_thread thread, pointer frontier);
 
 size_t HM_HH_nextCollectionThreshold(GC_state s, size_t survivingSize);
+void HM_HH_recordLocalCollection(
+  GC_state s,
+  size_t bytesInScope,
+  struct timespec *pause);
 size_t HM_HH_addRecentBytesAllocated(GC_thread thread, size_t bytes);
 
 uint32_t HM_HH_desiredCollectionScope(GC_state s, GC_thread thread);
@@ -211,6 +211,9 @@ int processAtMLton (GC_state s, int start, int argc, char **argv,
         } else if (0 == strcmp (arg, "heartbeat-stats")) {
           i++;
           s->controls->heartbeatStats = TRUE;
+        } else if (0 == strcmp (arg, "cc-line-stats")) {
+          i++;
+          s->controls->ccLineStats = TRUE;
         } else if (0 == strcmp (arg, "heartbeat-us")) {
           i++;
           if (i == argc || (0 == strcmp (argv[i], "--")))
@@ -224,6 +227,33 @@ int processAtMLton (GC_state s, int start, int argc, char **argv,
           if (toks < 0)
             die ("%s heartbeat-tokens argument must be non-negative.", atName);
           s->controls->heartbeatTokens = (uint32_t)toks;
+        } else if (0 == strcmp (arg, "thread-stack-pool-size")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--")))
+            die ("%s thread-stack-pool-size missing argument.", atName);
+          s->controls->threadStackPoolSize = stringToBytes (argv[i++]);
+        } else if (0 == strcmp (arg, "aio-threads")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--")))
+            die ("%s aio-threads missing argument.", atName);
+          int threads = stringToInt (argv[i++]);
+          if (threads < 1)
+            die ("%s aio-threads argument must be at least 1.", atName);
+          s->controls->aioThreads = (uint32_t)threads;
+        } else if (0 == strcmp (arg, "gc-prefetch-depth")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--")))
+            die ("%s gc-prefetch-depth missing argument.", atName);
+          int depth = stringToInt (argv[i++]);
+          if (depth < 0 || depth > PREFETCH_QUEUE_MAX_DEPTH)
+            die ("%s gc-prefetch-depth argument must be between 0 and %d.",
+                 atName, PREFETCH_QUEUE_MAX_DEPTH);
+          s->controls->gcPrefetchDepth = (uint32_t)depth;
+        } else if (0 == strcmp (arg, "gc-nontemporal-copy-min")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--")))
+            die ("%s gc-nontemporal-copy-min missing argument.", atName);
+          s->controls->nonTemporalCopyMinBytes = stringToBytes (argv[i++]);
         } else if (0 == strcmp (arg, "heartbeat-relayer-threshold")) {
           i++;
           if (i == argc || (0 == strcmp (argv[i], "--")))
@@ -399,6 +429,22 @@ int processAtMLton (GC_state s, int start, int argc, char **argv,
           struct timespec tm;
           stringToTime(argv[i++], &tm);
           s->controls->blockUsageSampleInterval = tm;
+        } else if (0 == strcmp (arg, "metrics-socket")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--"))) {
+            die ("%s metrics-socket missing argument.", atName);
+          }
+          s->controls->metricsSocket = argv[i++];
+          if (strlen(s->controls->metricsSocket) >=
+              sizeof(((struct sockaddr_un *)0)->sun_path)) {
+            die ("%s metrics-socket path too long.", atName);
+          }
+        } else if (0 == strcmp (arg, "max-heap")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--"))) {
+            die ("%s max-heap missing argument.", atName);
+          }
+          s->controls->maxHeap = stringToBytes(argv[i++]);
         } else if (0 == strcmp (arg, "collection-type")) {
           i++;
           if (i == argc || (0 == strcmp (argv[i], "--"))) {
@@ -437,6 +483,17 @@ int processAtMLton (GC_state s, int start, int argc, char **argv,
           if (s->controls->hhConfig.ccThresholdRatio <= 1.0) {
             die("%s cc-threshold-ratio must be > 1.0", atName);
           }
+        } else if (0 == strcmp (arg, "cc-compact-threshold")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--"))) {
+            die ("%s cc-compact-threshold missing argument.", atName);
+          }
+
+          s->controls->hhConfig.ccCompactThreshold = stringToFloat(argv[i++]);
+          if (s->controls->hhConfig.ccCompactThreshold < 0.0 ||
+              s->controls->hhConfig.ccCompactThreshold > 1.0) {
+            die("%s cc-compact-threshold must be between 0.0 and 1.0", atName);
+          }
         } else if (0 == strcmp(arg, "min-collection-size")) {
           i++;
           if (i == argc || (0 == strcmp (argv[i], "--"))) {
@@ -444,6 +501,17 @@ int processAtMLton (GC_state s, int start, int argc, char **argv,
           }
 
           s->controls->hhConfig.minCollectionSize = stringToBytes(argv[i++]);
+        } else if (0 == strcmp(arg, "lgc-pause-target-us")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--"))) {
+            die ("%s lgc-pause-target-us missing argument.", atName);
+          }
+
+          int target = stringToInt(argv[i++]);
+          if (target < 0) {
+            die("%s lgc-pause-target-us must be non-negative", atName);
+          }
+          s->controls->hhConfig.lgcPauseTargetUs = (uint32_t)target;
         } else if (0 == strcmp(arg, "min-cc-size")) {
           i++;
           if (i == argc || (0 == strcmp (argv[i], "--"))) {
@@ -490,7 +558,30 @@ int processAtMLton (GC_state s, int start, int argc, char **argv,
             die ("%s trace-buffer-size missing argument.", atName);
           }
 
-          s->controls->traceBufferSize = stringToInt(argv[i++]);
+          int size = stringToInt(argv[i++]);
+          if (size < 2) {
+            die ("%s trace-buffer-size must be at least 2", atName);
+          }
+          s->controls->traceBufferSize = size;
+        } else if (0 == strcmp(arg, "trace-sample-rate")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--"))) {
+            die ("%s trace-sample-rate missing argument.", atName);
+          }
+
+          int rate = stringToInt(argv[i++]);
+          if (rate < 0) {
+            die ("%s trace-sample-rate must be non-negative", atName);
+          }
+          s->controls->traceSampleRate = rate;
+        } else if (0 == strcmp(arg, "trace-sample-threshold")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--"))) {
+            die ("%s trace-sample-threshold missing argument.", atName);
+          }
+          struct timespec tm;
+          stringToTime(argv[i++], &tm);
+          s->controls->traceSampleThreshold = tm;
         } else if (0 == strcmp (arg, "--")) {
           i++;
           done = TRUE;
@@ -537,9 +628,11 @@ int GC_init (GC_state s, int argc, char **argv) {
   s->controls->ratios.stackShrink = 0.5f;
   s->controls->hhConfig.collectionThresholdRatio = 8.0;
   s->controls->hhConfig.minCollectionSize = 1024L * 1024L;
+  s->controls->hhConfig.lgcPauseTargetUs = 0;
   s->controls->hhConfig.minCCSize = 1024L * 1024L;
   s->controls->hhConfig.maxCCChainLength = 2;
   s->controls->hhConfig.ccThresholdRatio = 2.0f;
+  s->controls->hhConfig.ccCompactThreshold = 0.0;
   s->controls->hhConfig.maxCCDepth = 3;
   s->controls->hhConfig.minLocalDepth = 2;
   s->controls->rusageMeasureGC = FALSE;
@@ -548,6 +641,12 @@ int GC_init (GC_state s, int argc, char **argv) {
   s->controls->summaryFile = stderr;
   s->controls->collectionType = ALL;
   s->controls->traceBufferSize = 10000;
+  s->controls->traceSampleRate = 0;
+  // default: in sampled mode, record collections of at least 1ms
+  s->controls->traceSampleThreshold.tv_sec = 0;
+  s->controls->traceSampleThreshold.tv_nsec = 1000000;
+  s->controls->metricsSocket = NULL;
+  s->controls->maxHeap = 0;
   s->controls->emptinessFraction = 0.25;
   s->controls->superblockThreshold = 7;  // superblocks of 128 blocks
   s->controls->megablockThreshold = 18;
@@ -558,9 +657,14 @@ int GC_init (GC_state s, int argc, char **argv) {
   s->controls->blockUsageSampleInterval.tv_nsec = 0;
 
   s->controls->heartbeatStats = FALSE;
+  s->controls->ccLineStats = FALSE;
   s->controls->heartbeatMicroseconds = 500;
   s->controls->heartbeatTokens = 30;
   s->controls->heartbeatRelayerThreshold = 16;
+  s->controls->threadStackPoolSize = 1024 * 1024;
+  s->controls->gcPrefetchDepth = 8;
+  s->controls->nonTemporalCopyMinBytes = 1024;
+  s->controls->aioThreads = 4;
 
   /* Not arbitrary; should be at least the page size and must also respect the
    * limit check coalescing amount in the compiler. */
@@ -607,11 +711,14 @@ int GC_init (GC_state s, int argc, char **argv) {
   s->self = pthread_self();
   s->terminationLeader = INVALID_PROCESSOR_NUMBER;
   s->terminationStatus = 1;
+  HM_initChunkList(&(s->threadStackPool));
+  s->localGCBytesPerUs = 0.0;
   s->sysvals.pageSize = GC_pageSize ();
   s->sysvals.physMem = GC_physMem ();
   s->weaks = NULL;
   s->saveWorldStatus = true;
   s->trace = NULL;
+  memset(&s->traceSample, 0, sizeof(s->traceSample));
   srand48_r(0, &(s->tlsObjects.drand48_data));
 
   /* RAM_NOTE: Why is this not found in the Spoonhower copy? */
@@ -697,6 +804,7 @@ void GC_lateInit(GC_state s) {
 
   initLocalBlockAllocator(s, initGlobalBlockAllocator(s));
   s->blockUsageSampler = newBlockUsageSampler(s);
+  s->heapPressureSampler = newHeapPressureSampler(s);
 
   s->nextChunkAllocSize = s->controls->allocChunkSize;
 
@@ -733,6 +841,7 @@ void GC_duplicate (GC_state d, GC_state s) {
   d->wsQueueBot = BOGUS_OBJPTR;
   initLocalBlockAllocator(d, s->blockAllocatorGlobal);
   d->blockUsageSampler = s->blockUsageSampler;
+  d->heapPressureSampler = s->heapPressureSampler;
   initFixedSizeAllocator(getHHAllocator(d), sizeof(struct HM_HierarchicalHeap), BLOCK_FOR_HH_ALLOCATOR);
   initFixedSizeAllocator(getUFAllocator(d), sizeof(struct HM_UnionFindNode), BLOCK_FOR_UF_ALLOCATOR);
   d->hhEBR = s->hhEBR;
@@ -756,11 +865,14 @@ void GC_duplicate (GC_state d, GC_state s) {
   d->self = s->self;
   d->terminationLeader = INVALID_PROCESSOR_NUMBER;
   d->terminationStatus = 1;
+  HM_initChunkList(&(d->threadStackPool));
+  d->localGCBytesPerUs = 0.0;
   d->sysvals.pageSize = s->sysvals.pageSize;
   d->sysvals.physMem = s->sysvals.physMem;
   d->weaks = s->weaks;
   d->saveWorldStatus = s->saveWorldStatus;
   d->trace = NULL;
+  memset(&d->traceSample, 0, sizeof(d->traceSample));
   srand48_r(0, &(d->tlsObjects.drand48_data));
 
   // SPOONHOWER_NOTE: better duplicate?
@@ -778,23 +890,28 @@ void GC_duplicate (GC_state d, GC_state s) {
 }
 
 // AG_NOTE: is this the proper place for this function?
-void GC_traceInit(ARG_USED_FOR_TRACING GC_state s) {
-#ifdef ENABLE_TRACING
+void GC_traceInit(GC_state s) {
   char filename[256];
   const char *dir;
 
   dir = getenv("MLTON_TRACE_DIR");
+#ifdef ENABLE_TRACING
   if (dir == NULL)
     return;
+#else
+  /* Sampled tracing is requested explicitly, so default to the current
+   * directory. */
+  if (s->controls->traceSampleRate == 0)
+    return;
+  if (dir == NULL)
+    dir = ".";
+#endif
 
   snprintf(filename, 256, "%s/%d.%d.trace", dir, getpid(), s->procNumber);
   s->trace = TracingNewContext(filename, s->controls->traceBufferSize,
                                s->procNumber);
-#endif
 }
 
-void GC_traceFinish(ARG_USED_FOR_TRACING GC_state s) {
-#ifdef ENABLE_TRACING
+void GC_traceFinish(GC_state s) {
   TracingCloseAndFreeContext(&s->trace);
-#endif
 }
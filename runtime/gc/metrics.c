@@ -0,0 +1,308 @@
+/* MLton is released under a HPND-style license.
+ * See the file MLton-LICENSE for details.
+ */
+
+#if (defined (MLTON_GC_INTERNAL_FUNCS))
+
+static int metricsListenFd = -1;
+
+static const char *blockPurposeNames[NUM_BLOCK_PURPOSES] = {
+  [BLOCK_FOR_HEAP_CHUNK] = "heap_chunk",
+  [BLOCK_FOR_REMEMBERED_SET] = "remembered_set",
+  [BLOCK_FOR_FORGOTTEN_SET] = "forgotten_set",
+  [BLOCK_FOR_HH_ALLOCATOR] = "hh_allocator",
+  [BLOCK_FOR_UF_ALLOCATOR] = "uf_allocator",
+  [BLOCK_FOR_GC_WORKLIST] = "gc_worklist",
+  [BLOCK_FOR_SUSPECTS] = "suspects",
+  [BLOCK_FOR_EBR] = "ebr",
+  [BLOCK_FOR_UNKNOWN_PURPOSE] = "unknown",
+};
+
+static inline double metricsSeconds(struct timespec *t) {
+  return (double)t->tv_sec + (double)t->tv_nsec / 1e9;
+}
+
+static void writeMetricHeader(
+  FILE *out,
+  const char *name,
+  const char *type,
+  const char *help)
+{
+  fprintf(out, "# HELP %s %s\n", name, help);
+  fprintf(out, "# TYPE %s %s\n", name, type);
+}
+
+/* One per-processor counter, read from each processor's cumulative
+ * statistics at the given offset. */
+static void writePerProcCounter(
+  GC_state s,
+  FILE *out,
+  const char *name,
+  const char *help,
+  size_t offset)
+{
+  writeMetricHeader(out, name, "counter", help);
+  for (uint32_t p = 0; p < s->numberOfProcs; p++) {
+    char *stats = (char *)s->procStates[p].cumulativeStatistics;
+    fprintf(out, "%s{proc=\"%"PRIu32"\"} %"PRIuMAX"\n",
+            name, p, *(uintmax_t *)(stats + offset));
+  }
+}
+
+static void writePerProcSeconds(
+  GC_state s,
+  FILE *out,
+  const char *name,
+  const char *help,
+  size_t offset)
+{
+  writeMetricHeader(out, name, "counter", help);
+  for (uint32_t p = 0; p < s->numberOfProcs; p++) {
+    char *stats = (char *)s->procStates[p].cumulativeStatistics;
+    struct timespec t = *(struct timespec *)(stats + offset);
+    fprintf(out, "%s{proc=\"%"PRIu32"\"} %.9f\n", name, p, metricsSeconds(&t));
+  }
+}
+
+/* A TimeHistogram as a Prometheus histogram. The histogram does not track a
+ * sum, so only the buckets and the count are reported. */
+static void writeHeartbeatHistogram(
+  GC_state s,
+  FILE *out,
+  const char *name,
+  const char *help,
+  bool handlers)
+{
+  writeMetricHeader(out, name, "histogram", help);
+  for (uint32_t p = 0; p < s->numberOfProcs; p++) {
+    struct GC_cumulativeStatistics *cs = s->procStates[p].cumulativeStatistics;
+    TimeHistogram h = handlers ? cs->heartbeatHandlers : cs->heartbeatSignals;
+    double width = metricsSeconds(&(h->bucketWidth));
+    size_t total = 0;
+    for (size_t i = 0; i < h->numBuckets; i++) {
+      total += h->buckets[i];
+      if (i + 1 < h->numBuckets) {
+        fprintf(out, "%s_bucket{proc=\"%"PRIu32"\",le=\"%g\"} %zu\n",
+                name, p, width * (double)(i + 1), total);
+      } else {
+        fprintf(out, "%s_bucket{proc=\"%"PRIu32"\",le=\"+Inf\"} %zu\n",
+                name, p, total);
+      }
+    }
+    fprintf(out, "%s_count{proc=\"%"PRIu32"\"} %zu\n", name, p, total);
+  }
+}
+
+void writeMetrics(GC_state s, FILE *out) {
+  size_t mapped;
+  size_t globalMapped;
+  size_t released;
+  size_t globalReleased;
+  size_t allocated[NUM_BLOCK_PURPOSES];
+  size_t freed[NUM_BLOCK_PURPOSES];
+
+  queryCurrentBlockUsage(
+    s,
+    &mapped,
+    &globalMapped,
+    &released,
+    &globalReleased,
+    allocated,
+    freed);
+
+  /* The counters are read racily, so clamp differences at zero. */
+  size_t inUse = (released > mapped) ? 0 : mapped - released;
+
+  writeMetricHeader(out, "mpl_heap_bytes", "gauge",
+    "Bytes currently mapped by the block allocator.");
+  fprintf(out, "mpl_heap_bytes %zu\n", inUse * s->controls->blockSize);
+
+  writeMetricHeader(out, "mpl_max_heap_occupancy_bytes", "gauge",
+    "Maximum global heap occupancy observed so far.");
+  fprintf(out, "mpl_max_heap_occupancy_bytes %zu\n",
+          s->globalCumulativeStatistics->maxHeapOccupancy);
+
+  writeMetricHeader(out, "mpl_heap_pressure", "gauge",
+    "Heap pressure level relative to max-heap (0 = none, 3 = throttling).");
+  fprintf(out, "mpl_heap_pressure %"PRIu32"\n",
+          s->blockAllocatorGlobal->heapPressure);
+
+  writeMetricHeader(out, "mpl_blocks_in_use", "gauge",
+    "Blocks currently allocated, by purpose.");
+  for (enum BlockPurpose p = 0; p < NUM_BLOCK_PURPOSES; p++) {
+    fprintf(out, "mpl_blocks_in_use{purpose=\"%s\"} %zu\n",
+            blockPurposeNames[p],
+            (freed[p] > allocated[p]) ? 0 : allocated[p] - freed[p]);
+  }
+
+  writeMetricHeader(out, "mpl_blocks_allocated_total", "counter",
+    "Blocks allocated, by purpose.");
+  for (enum BlockPurpose p = 0; p < NUM_BLOCK_PURPOSES; p++) {
+    fprintf(out, "mpl_blocks_allocated_total{purpose=\"%s\"} %zu\n",
+            blockPurposeNames[p], allocated[p]);
+  }
+
+  writeMetricHeader(out, "mpl_blocks_freed_total", "counter",
+    "Blocks freed, by purpose.");
+  for (enum BlockPurpose p = 0; p < NUM_BLOCK_PURPOSES; p++) {
+    fprintf(out, "mpl_blocks_freed_total{purpose=\"%s\"} %zu\n",
+            blockPurposeNames[p], freed[p]);
+  }
+
+#define PER_PROC_COUNTER(name, field, help) \
+  writePerProcCounter(s, out, name, help, \
+    offsetof(struct GC_cumulativeStatistics, field))
+
+  PER_PROC_COUNTER("mpl_bytes_allocated_total", bytesAllocated,
+    "Bytes allocated.");
+  PER_PROC_COUNTER("mpl_bytes_promoted_total", bytesPromoted,
+    "Bytes copied by promotions.");
+  PER_PROC_COUNTER("mpl_bytes_pinned_down_total", bytesPinnedDown,
+    "Bytes of objects pinned in place as down-pointer targets.");
+  PER_PROC_COUNTER("mpl_local_gc_bytes_copied_total", bytesHHLocaled,
+    "Bytes copied by local collections.");
+  PER_PROC_COUNTER("mpl_local_gc_bytes_reclaimed_total", bytesReclaimedByLocal,
+    "Bytes reclaimed by local collections.");
+  PER_PROC_COUNTER("mpl_cc_bytes_reclaimed_total", bytesReclaimedByCC,
+    "Bytes reclaimed by concurrent collections.");
+  PER_PROC_COUNTER("mpl_cc_bytes_sparse_total", bytesSparseAfterCC,
+    "Dead bytes left in chunks retained by concurrent collections.");
+  PER_PROC_COUNTER("mpl_cc_lines_total", numCCLines,
+    "Lines of multi-object chunks retained by concurrent collections (with @mpl cc-line-stats).");
+  PER_PROC_COUNTER("mpl_cc_live_lines_total", numCCLiveLines,
+    "Retained lines that overlap a live object.");
+  PER_PROC_COUNTER("mpl_compacting_local_gcs_total", numCompactingLocalGCs,
+    "Local collections that evacuated a level left sparse by CC.");
+  PER_PROC_COUNTER("mpl_compacted_from_bytes_total", bytesCompactedFrom,
+    "Scope size before compacting local collections.");
+  PER_PROC_COUNTER("mpl_compacted_to_bytes_total", bytesCompactedTo,
+    "Scope size after compacting local collections.");
+  PER_PROC_COUNTER("mpl_local_gcs_total", numHHLocalGCs,
+    "Local collections performed.");
+  PER_PROC_COUNTER("mpl_ccs_total", numCCs,
+    "Concurrent collections performed.");
+  PER_PROC_COUNTER("mpl_entanglements_total", numEntanglements,
+    "Entanglements detected.");
+  PER_PROC_COUNTER("mpl_bytes_pinned_entangled_total", bytesPinnedEntangled,
+    "Bytes pinned due to entanglement.");
+  PER_PROC_COUNTER("mpl_thread_stack_pool_hits_total", numThreadStackPoolHits,
+    "Stack chunk requests served from the stack pool.");
+  PER_PROC_COUNTER("mpl_thread_stack_pool_misses_total", numThreadStackPoolMisses,
+    "Stack chunk requests that fell back to the block allocator.");
+
+  PER_PROC_COUNTER("mpl_heap_throttles_total", numHeapThrottles,
+    "Back-offs by allocating processors under heap pressure.");
+  PER_PROC_COUNTER("mpl_heap_limit_waits_total", numHeapLimitWaits,
+    "Waits for memory to be freed at the max-heap limit.");
+
+#undef PER_PROC_COUNTER
+
+  writePerProcSeconds(s, out, "mpl_local_gc_seconds_total",
+    "Time spent in local collections.",
+    offsetof(struct GC_cumulativeStatistics, timeLocalGC));
+  writePerProcSeconds(s, out, "mpl_promotion_seconds_total",
+    "Time spent in promotions.",
+    offsetof(struct GC_cumulativeStatistics, timeLocalPromo));
+  writePerProcSeconds(s, out, "mpl_cc_seconds_total",
+    "Time spent in concurrent collections.",
+    offsetof(struct GC_cumulativeStatistics, timeCC));
+
+  writeHeartbeatHistogram(s, out, "mpl_heartbeat_signal_interval_seconds",
+    "Time between consecutive heartbeat signals.", FALSE);
+  writeHeartbeatHistogram(s, out, "mpl_heartbeat_handler_interval_seconds",
+    "Time between consecutive heartbeat handlers.", TRUE);
+}
+
+/* Wait briefly for a request. Returns TRUE if the client sent an HTTP
+ * request, in which case the headers have been consumed. */
+static bool metricsReadRequest(int fd) {
+  char buf[1024];
+  size_t len = 0;
+  struct pollfd pfd = { .fd = fd, .events = POLLIN, .revents = 0 };
+
+  while (len < sizeof(buf) - 1 && poll(&pfd, 1, 100) > 0) {
+    ssize_t n = read(fd, buf + len, sizeof(buf) - 1 - len);
+    if (n <= 0)
+      break;
+    len += n;
+    buf[len] = '\0';
+    if (strstr(buf, "\r\n\r\n") != NULL || strstr(buf, "\n\n") != NULL)
+      break;
+  }
+
+  return len >= 4 && 0 == strncmp(buf, "GET ", 4);
+}
+
+static void *metricsServerLoop(void *arg) {
+  GC_state s = (GC_state)arg;
+
+  while (TRUE) {
+    int conn = accept(metricsListenFd, NULL, NULL);
+    if (conn < 0) {
+      if (errno == EINTR || errno == ECONNABORTED)
+        continue;
+      /* The socket was closed by GC_metricsFinish. */
+      return NULL;
+    }
+
+    bool http = metricsReadRequest(conn);
+    FILE *out = fdopen(conn, "w");
+    if (out == NULL) {
+      close(conn);
+      continue;
+    }
+    if (http) {
+      fprintf(out, "HTTP/1.0 200 OK\r\n"
+                   "Content-Type: text/plain; version=0.0.4\r\n"
+                   "Connection: close\r\n\r\n");
+    }
+    writeMetrics(s, out);
+    fclose(out);
+  }
+}
+
+#endif /* MLTON_GC_INTERNAL_FUNCS */
+
+void GC_metricsInit(GC_state s) {
+  const char *path = s->controls->metricsSocket;
+  struct sockaddr_un addr;
+  pthread_t server;
+  sigset_t all, old;
+
+  if (path == NULL)
+    return;
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, path);
+
+  metricsListenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (metricsListenFd < 0)
+    diee("metrics-socket: socket failed");
+  /* A stale socket from an earlier run would make bind fail. */
+  unlink(path);
+  if (bind(metricsListenFd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    diee("metrics-socket: could not bind %s", path);
+  if (listen(metricsListenFd, 8) < 0)
+    diee("metrics-socket: listen failed");
+
+  /* The server must never run signal handlers meant for the workers. With
+   * SIGPIPE blocked, a client hanging up early makes the write fail with
+   * EPIPE instead of killing the process. */
+  sigfillset(&all);
+  pthread_sigmask(SIG_SETMASK, &all, &old);
+  if (pthread_create(&server, NULL, metricsServerLoop, (void *)s))
+    die("metrics-socket: could not start server thread");
+  pthread_detach(server);
+  pthread_sigmask(SIG_SETMASK, &old, NULL);
+}
+
+void GC_metricsFinish(GC_state s) {
+  if (metricsListenFd < 0)
+    return;
+
+  shutdown(metricsListenFd, SHUT_RDWR);
+  close(metricsListenFd);
+  metricsListenFd = -1;
+  unlink(s->controls->metricsSocket);
+}
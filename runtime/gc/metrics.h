@@ -0,0 +1,31 @@
+/* MLton is released under a HPND-style license.
+ * See the file MLton-LICENSE for details.
+ */
+
+/** Live metrics endpoint. With @mpl metrics-socket <path>, a runtime thread
+  * listens on a Unix domain socket at <path> and answers each connection
+  * with a snapshot of the GC statistics in the Prometheus text exposition
+  * format. If the client sends an HTTP request (e.g. a Prometheus scrape via
+  * a socket proxy, or `curl --unix-socket`), the snapshot is wrapped in an
+  * HTTP response; otherwise the bare text is written and the connection is
+  * closed.
+  *
+  * Per-processor counters are read without synchronizing with the
+  * processors that update them, so a snapshot may be slightly stale, but the
+  * world is never stopped.
+  */
+
+#ifndef METRICS_H_
+#define METRICS_H_
+
+#if (defined (MLTON_GC_INTERNAL_FUNCS))
+
+/* Write one snapshot of all metrics to out. */
+void writeMetrics(GC_state s, FILE *out);
+
+#endif /* MLTON_GC_INTERNAL_FUNCS */
+
+PRIVATE void GC_metricsInit (GC_state s);
+PRIVATE void GC_metricsFinish (GC_state s);
+
+#endif /* METRICS_H_ */
@@ -151,10 +151,16 @@ GC_thread newThreadWithHeap(
     threadSize,
     BLOCK_FOR_HEAP_CHUNK);
     
-  HM_chunk sChunk = HM_allocateChunkWithPurpose(
+  HM_chunk sChunk = takeThreadStackChunk(
+    s,
     HM_HH_getChunkList(hh),
-    stackSize,
-    BLOCK_FOR_HEAP_CHUNK);
+    stackSize);
+  if (NULL == sChunk) {
+    sChunk = HM_allocateChunkWithPurpose(
+      HM_HH_getChunkList(hh),
+      stackSize,
+      BLOCK_FOR_HEAP_CHUNK);
+  }
     
   if (NULL == sChunk || NULL == tChunk) {
     DIE("Ran out of space for thread+stack allocation!");
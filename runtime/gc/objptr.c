@@ -5,11 +5,13 @@
  * See the file MLton-LICENSE for details.
  */
 
-/* isObjptr returns true if p looks like an object pointer. */
+/* isObjptr returns true if p looks like an object pointer. Zero is never an
+ * object pointer; like BOGUS_OBJPTR, it may appear in not-yet-initialized
+ * sequence slots (see sequenceInitialize). */
 bool isObjptr (objptr p) {
   unsigned int shift = GC_MODEL_MINALIGN_SHIFT - GC_MODEL_OBJPTR_SHIFT;
   objptr mask = ~((~((objptr)0)) << shift);
-  return (0 == (p & mask));
+  return (0 != p) and (0 == (p & mask));
 }
 
 pointer objptrToPointer (objptr O, pointer B) {
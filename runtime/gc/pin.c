@@ -125,6 +125,9 @@ objptr pinObjectInfo(
             (uintmax_t)sz
           );
         }
+        else if (nt == PIN_DOWN && pinType(header) == PIN_NONE) {
+          s->cumulativeStatistics->bytesPinnedDown += objectSize(s, p);
+        }
         assert (!hasFwdPtr(p));
         assert(pinType(newHeader) == nt);
         return op;
@@ -0,0 +1,60 @@
+/* MLton is released under a HPND-style license.
+ * See the file MLton-LICENSE for details.
+ */
+
+static inline void PrefetchQueue_init(PrefetchQueue q, uint32_t depth) {
+  assert(depth <= PREFETCH_QUEUE_MAX_DEPTH);
+  q->depth = depth;
+  q->head = 0;
+  q->size = 0;
+}
+
+static inline bool PrefetchQueue_push(
+  PrefetchQueue q,
+  objptr *opp,
+  objptr context,
+  struct PrefetchQueue_elem *out)
+{
+  if (0 == q->depth) {
+    out->opp = opp;
+    out->context = context;
+    return TRUE;
+  }
+
+  objptr op = *opp;
+  if (isObjptr(op)) {
+    /* read, moderate temporal locality: the header is inspected (and
+     * usually written) soon, but the object is not otherwise revisited. */
+    __builtin_prefetch(objptrToPointer(op, NULL) - GC_HEADER_SIZE, 0, 1);
+  }
+
+  bool full = (q->size == q->depth);
+  if (full) {
+    *out = q->elems[q->head];
+    q->head = (q->head + 1) % q->depth;
+    q->size--;
+  }
+
+  uint32_t tail = (q->head + q->size) % q->depth;
+  q->elems[tail].opp = opp;
+  q->elems[tail].context = context;
+  q->size++;
+  return full;
+}
+
+static inline bool PrefetchQueue_pop(
+  PrefetchQueue q,
+  struct PrefetchQueue_elem *out)
+{
+  if (0 == q->size)
+    return FALSE;
+
+  *out = q->elems[q->head];
+  q->head = (q->head + 1) % q->depth;
+  q->size--;
+  return TRUE;
+}
+
+static inline bool PrefetchQueue_isEmpty(PrefetchQueue q) {
+  return 0 == q->size;
+}
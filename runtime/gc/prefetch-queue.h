@@ -0,0 +1,65 @@
+/* MLton is released under a HPND-style license.
+ * See the file MLton-LICENSE for details.
+ */
+
+/** A small FIFO of fields waiting to be traced. When a field is enqueued,
+  * the header of the object it points to is prefetched; the field is handed
+  * back for tracing only once @mpl gc-prefetch-depth other fields have been
+  * enqueued behind it, which gives the prefetch time to land. With depth 0
+  * the queue is a pass-through.
+  *
+  * Each entry also remembers an opaque "context" word, so that callers whose
+  * trace function depends on state at the time of enqueue (e.g. the object
+  * containing the field) can restore it before processing.
+  */
+
+#ifndef PREFETCH_QUEUE_H_
+#define PREFETCH_QUEUE_H_
+
+#define PREFETCH_QUEUE_MAX_DEPTH 64
+
+#if (defined (MLTON_GC_INTERNAL_TYPES))
+
+struct PrefetchQueue_elem {
+  objptr *opp;
+  objptr context;
+};
+
+typedef struct PrefetchQueue {
+  struct PrefetchQueue_elem elems[PREFETCH_QUEUE_MAX_DEPTH];
+  uint32_t depth;
+  uint32_t head;
+  uint32_t size;
+} * PrefetchQueue;
+
+#else
+
+struct PrefetchQueue;
+typedef struct PrefetchQueue * PrefetchQueue;
+
+#endif /* MLTON_GC_INTERNAL_TYPES */
+
+#if (defined (MLTON_GC_INTERNAL_FUNCS))
+
+static inline void PrefetchQueue_init(PrefetchQueue q, uint32_t depth);
+
+/** Enqueue a field and prefetch its target. If this pushed the queue past
+  * its depth, the oldest entry is dequeued into *out and TRUE is returned.
+  * With depth 0, the field itself is returned immediately.
+  */
+static inline bool PrefetchQueue_push(
+  PrefetchQueue q,
+  objptr *opp,
+  objptr context,
+  struct PrefetchQueue_elem *out);
+
+/** Dequeue the oldest entry into *out. Returns FALSE if the queue is empty. */
+static inline bool PrefetchQueue_pop(
+  PrefetchQueue q,
+  struct PrefetchQueue_elem *out);
+
+static inline bool PrefetchQueue_isEmpty(PrefetchQueue q);
+
+#endif /* MLTON_GC_INTERNAL_FUNCS */
+
+#endif /* PREFETCH_QUEUE_H_ */
@@ -22,6 +22,8 @@
  * @param header The sequence header
  * @param bytesNonObjptrs Number of non-objptr bytes per element
  * @param numObjptrs Number of objptrs per element
+ * @param knownZero Whether the memory is known to be zero already, in which
+ *                  case objptr slots need not be initialized
  *
  * @return The pointer to the start of the sequence object, after the headers
  */
@@ -31,7 +33,8 @@ static inline pointer sequenceInitialize(ARG_USED_FOR_ASSERT GC_state s,
                                          GC_sequenceLength numElements,
                                       GC_header header,
                                       uint16_t bytesNonObjptrs,
-                                      uint16_t numObjptrs);
+                                      uint16_t numObjptrs,
+                                      bool knownZero);
 
 /************************/
 /* Function Definitions */
@@ -75,10 +78,14 @@ pointer allocateSmallSequence(
 }
 
 
+/** A large sequence gets a chunk of its own. If that chunk was freshly
+  * mapped, *knownZero is set, and the contents of the sequence are zero.
+  */
 pointer allocateLargeSequence(
   GC_state s,
   size_t sequenceSizeAligned,
-  size_t ensureBytesFree)
+  size_t ensureBytesFree,
+  bool *knownZero)
 {
   assert(sequenceSizeAligned >= s->controls->blockSize / 2);
 
@@ -107,6 +114,8 @@ pointer allocateLargeSequence(
   HM_HH_updateValues(thread, result + sequenceSizeAligned);
   assert(newChunk->mightContainMultipleObjects);
   newChunk->mightContainMultipleObjects = FALSE;
+  *knownZero = newChunk->knownZero;
+  newChunk->knownZero = FALSE;
 
   /** Now we need to set the frontier of the thread to a safe value.
     * (We can't leave as is, because this chunk we just allocated is only
@@ -175,10 +184,11 @@ pointer GC_sequenceAllocate (GC_state s,
 
   enter(s);
 
+  bool knownZero = FALSE;
   if (sequenceSizeAligned < s->controls->blockSize / 2)
     frontier = allocateSmallSequence(s, sequenceSizeAligned, ensureBytesFree);
   else
-    frontier = allocateLargeSequence(s, sequenceSizeAligned, ensureBytesFree);
+    frontier = allocateLargeSequence(s, sequenceSizeAligned, ensureBytesFree, &knownZero);
 
   result = sequenceInitialize(s,
                               frontier,
@@ -186,7 +196,8 @@ pointer GC_sequenceAllocate (GC_state s,
                               numElements,
                               header,
                               bytesNonObjptrs,
-                              numObjptrs);
+                              numObjptrs,
+                              knownZero);
 
   GC_profileAllocInc (s, sequenceSizeAligned);
 
@@ -238,7 +249,8 @@ static pointer sequenceInitialize(ARG_USED_FOR_ASSERT GC_state s,
                                   GC_sequenceLength numElements,
                                GC_header header,
                                uint16_t bytesNonObjptrs,
-                               uint16_t numObjptrs) {
+                               uint16_t numObjptrs,
+                               bool knownZero) {
   pointer last = frontier + sequenceSize;
 
   *((GC_sequenceCounter*)(frontier)) = 0;
@@ -256,8 +268,15 @@ static pointer sequenceInitialize(ARG_USED_FOR_ASSERT GC_state s,
   pointer result = frontier;
   assert (isAligned ((size_t)result, s->alignment));
 
-  /* Initialize all pointers with BOGUS_OBJPTR. */
-  if (1 <= numObjptrs and 0 < numElements) {
+  /* Initialize all pointers with BOGUS_OBJPTR. Freshly mapped memory is
+   * already zero, which isObjptr rejects just the same, so a huge sequence in
+   * a fresh chunk needs no pass over its elements here. */
+  if (1 <= numObjptrs and 0 < numElements and knownZero) {
+    LOG(LM_ALLOCATION, LL_DEBUG,
+        "Skipping initialization of %s bytes of fresh memory",
+        uintmaxToCommaString(sequenceSize));
+  }
+  else if (1 <= numObjptrs and 0 < numElements) {
     pointer p;
 
     if (0 == bytesNonObjptrs)
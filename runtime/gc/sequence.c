@@ -73,6 +73,11 @@ pointer indexSequenceAtObjptrIndex (GC_state s, pointer a,
 /* GC_sequenceCopy (ad, as, as, ss, l)
  *
  * Copy l elements of as starting at ss to ad starting at as.
+ *
+ * If the elements contain objptrs, the write barrier is applied to the
+ * whole destination range in one pass on either side of the copy, rather
+ * than per element. Disjoint ranges of the same destination may be copied
+ * by different processors at the same time.
  */
 void GC_sequenceCopy (GC_state s, pointer ad, size_t ds, pointer as, size_t ss, size_t l) {
   GC_header header;
@@ -86,5 +91,15 @@ void GC_sequenceCopy (GC_state s, pointer ad, size_t ds, pointer as, size_t ss,
   assert (tag == SEQUENCE_TAG);
 
   eltSize = bytesNonObjptrs + (numObjptrs * OBJPTR_SIZE);
+  if (0 == numObjptrs || 0 == l) {
+    GC_memmove (as + eltSize * ss, ad + eltSize * ds, eltSize * l);
+    return;
+  }
+
+  objptr dst = pointerToObjptr (ad, NULL);
+  Assignable_writeBarrierBeforeRange (s, dst, ad + eltSize * ds, l,
+                                      eltSize, bytesNonObjptrs, numObjptrs);
   GC_memmove (as + eltSize * ss, ad + eltSize * ds, eltSize * l);
+  Assignable_writeBarrierAfterRange (s, dst, ad + eltSize * ds, l,
+                                     eltSize, bytesNonObjptrs, numObjptrs);
 }
@@ -39,6 +39,7 @@ struct GC_cumulativeStatistics *newCumulativeStatistics(void) {
     malloc (sizeof (struct GC_cumulativeStatistics));
   cumulativeStatistics->bytesAllocated = 0;
   cumulativeStatistics->bytesPromoted = 0;
+  cumulativeStatistics->bytesPinnedDown = 0;
   cumulativeStatistics->bytesFilled = 0;
   cumulativeStatistics->bytesCopied = 0;
   cumulativeStatistics->bytesCopiedMinor = 0;
@@ -50,6 +51,13 @@ struct GC_cumulativeStatistics *newCumulativeStatistics(void) {
   cumulativeStatistics->bytesReclaimedByCC = 0;
   cumulativeStatistics->bytesInScopeForLocal = 0;
   cumulativeStatistics->bytesInScopeForCC = 0;
+  cumulativeStatistics->bytesRetainedByCC = 0;
+  cumulativeStatistics->bytesSparseAfterCC = 0;
+  cumulativeStatistics->numCCLines = 0;
+  cumulativeStatistics->numCCLiveLines = 0;
+  cumulativeStatistics->numCompactingLocalGCs = 0;
+  cumulativeStatistics->bytesCompactedFrom = 0;
+  cumulativeStatistics->bytesCompactedTo = 0;
   cumulativeStatistics->maxBytesLive = 0;
   cumulativeStatistics->maxBytesLiveSinceReset = 0;
   cumulativeStatistics->maxHeapSize = 0;
@@ -71,6 +79,10 @@ struct GC_cumulativeStatistics *newCumulativeStatistics(void) {
   cumulativeStatistics->numMinorGCs = 0;
   cumulativeStatistics->numHHLocalGCs = 0;
   cumulativeStatistics->numCCs = 0;
+  cumulativeStatistics->numThreadStackPoolHits = 0;
+  cumulativeStatistics->numThreadStackPoolMisses = 0;
+  cumulativeStatistics->numHeapThrottles = 0;
+  cumulativeStatistics->numHeapLimitWaits = 0;
   cumulativeStatistics->numDisentanglementChecks = 0;
   cumulativeStatistics->numEntanglements = 0;
   cumulativeStatistics->numChecksSkipped = 0;
@@ -106,6 +118,11 @@ struct GC_cumulativeStatistics *newCumulativeStatistics(void) {
   cumulativeStatistics->heartbeatHandlers = TimeHistogram_new(15, &bucketWidth);
   cumulativeStatistics->heartbeatSignals = TimeHistogram_new(15, &bucketWidth);
 
+  bucketWidth.tv_nsec = 50 * 1000; // 50 us, up to 100 ms
+  cumulativeStatistics->localGCPauses = TimeHistogram_new(2000, &bucketWidth);
+  cumulativeStatistics->maxLocalGCPause.tv_sec = 0;
+  cumulativeStatistics->maxLocalGCPause.tv_nsec = 0;
+
   return cumulativeStatistics;
 }
 
@@ -237,6 +254,10 @@ void S_outputCumulativeStatisticsJSON(
 
     fprintf(out, ", ");
 
+    fprintf(out, "\"bytesPinnedDown\" : %"PRIuMAX, statistics->bytesPinnedDown);
+
+    fprintf(out, ", ");
+
     fprintf(out, "\"maxGlobalHeapBytesLive\" : %"PRIuMAX, statistics->maxBytesLive);
 
     fprintf(out, ", ");
@@ -272,6 +293,76 @@ void S_outputCumulativeStatisticsJSON(
     fprintf(out, ", ");
 
     fprintf(out, "\"bytesHashConsed\" : %"PRIuMAX, statistics->bytesHashConsed);
+
+    fprintf(out, ", ");
+
+    fprintf(out,
+            "\"threadStackPoolHits\" : %"PRIuMAX,
+            statistics->numThreadStackPoolHits);
+
+    fprintf(out, ", ");
+
+    fprintf(out,
+            "\"threadStackPoolMisses\" : %"PRIuMAX,
+            statistics->numThreadStackPoolMisses);
+
+    fprintf(out, ", ");
+
+    fprintf(out,
+            "\"heapThrottles\" : %"PRIuMAX,
+            statistics->numHeapThrottles);
+
+    fprintf(out, ", ");
+
+    fprintf(out,
+            "\"heapLimitWaits\" : %"PRIuMAX,
+            statistics->numHeapLimitWaits);
+
+    fprintf(out, ", ");
+
+    {
+      TimeHistogram h = statistics->localGCPauses;
+      fprintf(out,
+              "\"localGCPauseP50Us\" : %"PRIuMAX", "
+              "\"localGCPauseP90Us\" : %"PRIuMAX", "
+              "\"localGCPauseP99Us\" : %"PRIuMAX", "
+              "\"localGCPauseMaxUs\" : %"PRIuMAX,
+              TimeHistogram_percentileUs(h, 0.5),
+              TimeHistogram_percentileUs(h, 0.9),
+              TimeHistogram_percentileUs(h, 0.99),
+              (uintmax_t)statistics->maxLocalGCPause.tv_sec * 1000000
+              + (uintmax_t)statistics->maxLocalGCPause.tv_nsec / 1000);
+    }
+
+    fprintf(out, ", ");
+
+    fprintf(out,
+            "\"ccRetainedBytes\" : %"PRIuMAX", "
+            "\"ccSparseBytes\" : %"PRIuMAX", "
+            "\"ccLines\" : %"PRIuMAX", "
+            "\"ccLiveLines\" : %"PRIuMAX", "
+            "\"compactingLocalGCs\" : %"PRIuMAX", "
+            "\"compactedFromBytes\" : %"PRIuMAX", "
+            "\"compactedToBytes\" : %"PRIuMAX,
+            statistics->bytesRetainedByCC,
+            statistics->bytesSparseAfterCC,
+            statistics->numCCLines,
+            statistics->numCCLiveLines,
+            statistics->numCompactingLocalGCs,
+            statistics->bytesCompactedFrom,
+            statistics->bytesCompactedTo);
+
+    fprintf(out, ", ");
+
+    {
+      double secs =
+        (double)statistics->timeLocalGC.tv_sec
+        + (double)statistics->timeLocalGC.tv_nsec / 1000000000.0;
+      fprintf(out,
+              "\"localGCCopiedGBPerSec\" : %.3f",
+              (0.0 == secs) ? 0.0 :
+              (double)statistics->bytesHHLocaled / secs / 1e9);
+    }
   }
   fprintf(out, " }");
 }
@@ -28,6 +28,9 @@ struct GC_globalCumulativeStatistics {
 struct GC_cumulativeStatistics {
   uintmax_t bytesAllocated;
   uintmax_t bytesPromoted;
+  /* bytes of down-pointer targets, which local collections leave pinned in
+   * place rather than copying; counted once per object, when first pinned */
+  uintmax_t bytesPinnedDown;
   uintmax_t bytesFilled; /* i.e. unused gaps */
   uintmax_t bytesCopied;
   uintmax_t bytesCopiedMinor;
@@ -39,6 +42,18 @@ struct GC_cumulativeStatistics {
   uintmax_t bytesReclaimedByCC;
   uintmax_t bytesInScopeForLocal;
   uintmax_t bytesInScopeForCC;
+  /* used bytes of chunks retained by CCs, and how many of those were dead */
+  uintmax_t bytesRetainedByCC;
+  uintmax_t bytesSparseAfterCC;
+  /* lines (CC_LINE_SIZE) of the multi-object chunks retained by CCs, and
+   * how many of them overlap a live object; only with @mpl cc-line-stats */
+  uintmax_t numCCLines;
+  uintmax_t numCCLiveLines;
+  /* local collections that evacuated a level left sparse by CC, and the
+   * size of their scope before and after */
+  uintmax_t numCompactingLocalGCs;
+  uintmax_t bytesCompactedFrom;
+  uintmax_t bytesCompactedTo;
 
   size_t maxBytesLive;
   size_t maxBytesLiveSinceReset;
@@ -68,6 +83,10 @@ struct GC_cumulativeStatistics {
   uintmax_t numMinorGCs;
   uintmax_t numHHLocalGCs;
   uintmax_t numCCs;
+  uintmax_t numThreadStackPoolHits;   // stack chunks taken from the stack pool
+  uintmax_t numThreadStackPoolMisses; // stack chunks the pool could not supply
+  uintmax_t numHeapThrottles;         // back-offs under heap pressure
+  uintmax_t numHeapLimitWaits;        // waits for memory at max-heap
   uintmax_t numDisentanglementChecks; // count full read barriers
   uintmax_t numEntanglements;         // count instances entanglement is detected
   uintmax_t numChecksSkipped;
@@ -98,6 +117,9 @@ struct GC_cumulativeStatistics {
   struct timespec lastHeartbeatSignalTimestamp;
   TimeHistogram heartbeatHandlers;
   TimeHistogram heartbeatSignals;
+
+  TimeHistogram localGCPauses;
+  struct timespec maxLocalGCPause;
 };
 
 struct GC_lastMajorStatistics {
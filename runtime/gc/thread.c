@@ -345,6 +345,7 @@ void GC_HH_joinIntoParent(
   assert(child != NULL);
   assert(child->hierarchicalHeap != NULL);
 
+  recycleThreadStack(s, child);
   HM_HH_merge(s, thread, child);
 
   /* ======================================================================== */
@@ -557,4 +558,79 @@ static inline GC_thread threadObjptrToStruct(GC_state s, objptr threadObjptr) {
   pointer threadPointer = objptrToPointer (threadObjptr, NULL);
   return ((GC_thread)(threadPointer + offsetofThread(s)));
 }
+
+void recycleThreadStack(GC_state s, GC_thread child) {
+  if (!isObjptr(child->stack))
+    return;
+
+  HM_HierarchicalHeap hh = child->hierarchicalHeap;
+
+  /* A concurrent collection of the child's heap may still be scanning (or
+   * remembering) the chunk, so it must not be reused. */
+  if (HM_HH_getConcurrentPack(hh)->ccstate != CC_UNREG)
+    return;
+
+  pointer stackp = objptrToPointer(child->stack, NULL);
+  HM_chunk chunk = HM_getChunkOf(stackp);
+
+  /* Only take chunks that hold nothing but this stack. Stacks that were
+   * allocated alongside other objects (e.g. by newThread, or copied during a
+   * local collection) are left for the collector. */
+  if (chunk->mightContainMultipleObjects ||
+      chunk->pinnedDuringCollection ||
+      chunk->retireChunk ||
+      HM_getChunkStart(chunk) + GC_STACK_METADATA_SIZE != stackp ||
+      HM_getLevelHead(chunk) != hh ||
+      !threadStackPoolHasRoom(s, chunk))
+  {
+    return;
+  }
+
+  child->stack = BOGUS_OBJPTR;
+  poolStackChunk(s, hh, chunk);
+}
+
+void poolStackChunk(
+  GC_state s,
+  struct HM_HierarchicalHeap *hh,
+  HM_chunk chunk)
+{
+  assert(!chunk->mightContainMultipleObjects);
+  HM_unlinkChunk(HM_HH_getChunkList(hh), chunk);
+  chunk->frontier = HM_getChunkStart(chunk);
+  chunk->decheckState = DECHECK_BOGUS_TID;
+  HM_prependChunk(&(s->threadStackPool), chunk);
+}
+
+bool threadStackPoolHasRoom(GC_state s, HM_chunk chunk) {
+  return HM_getChunkListSize(&(s->threadStackPool)) + HM_getChunkSize(chunk)
+         <= s->controls->threadStackPoolSize;
+}
+
+void releaseThreadStackPool(GC_state s) {
+  HM_freeChunksInListWithInfo(
+    s, &(s->threadStackPool), NULL, BLOCK_FOR_HEAP_CHUNK);
+}
+
+HM_chunk takeThreadStackChunk(
+  GC_state s,
+  HM_chunkList list,
+  size_t bytesRequested)
+{
+  for (HM_chunk c = HM_getChunkListFirstChunk(&(s->threadStackPool));
+       NULL != c;
+       c = c->nextChunk)
+  {
+    if (HM_getChunkSizePastFrontier(c) > bytesRequested) {
+      HM_unlinkChunk(&(s->threadStackPool), c);
+      s->cumulativeStatistics->bytesAllocated += HM_getChunkSize(c);
+      s->cumulativeStatistics->numThreadStackPoolHits++;
+      HM_appendChunk(list, c);
+      return c;
+    }
+  }
+
+  s->cumulativeStatistics->numThreadStackPoolMisses++;
+  return NULL;
+}
 #endif /* (defined (MLTON_GC_INTERNAL_FUNCS)) */
@@ -171,6 +171,41 @@ static inline size_t offsetofThread (GC_state s);
  */
 static inline GC_thread threadObjptrToStruct(GC_state s, objptr threadObjptr);
 
+/** Per-processor pool of stack chunks.
+ *
+ * When a child thread is joined, its stack is dead. If the stack sits alone
+ * in a chunk of the child's heap, recycleThreadStack detaches that chunk from
+ * the heap (leaving the child with a BOGUS stack) and caches it in
+ * s->threadStackPool, up to controls->threadStackPoolSize bytes.
+ *
+ * growStackCurrent does the same with the chunk a stack has just outgrown.
+ * poolStackChunk does the detaching; callers check threadStackPoolHasRoom
+ * first. Chunks of a heap that is being collected
+ * concurrently are never taken, since the collection may still be looking at
+ * them.
+ *
+ * takeThreadStackChunk hands a cached chunk with room for at least
+ * bytesRequested to the next thread created with newThreadWithHeap (e.g. a
+ * thief copying a forked thread) or to a growing stack, appending it to the
+ * given list. Returns NULL
+ * if no cached chunk is large enough.
+ *
+ * releaseThreadStackPool returns every cached chunk to the block allocator.
+ * It runs at each local collection and whenever the heap is under pressure,
+ * so that the chunks left behind by a deep recursion are not kept forever.
+ */
+static void recycleThreadStack(GC_state s, GC_thread child);
+static bool threadStackPoolHasRoom(GC_state s, HM_chunk chunk);
+static void releaseThreadStackPool(GC_state s);
+static void poolStackChunk(
+  GC_state s,
+  struct HM_HierarchicalHeap *hh,
+  HM_chunk chunk);
+static HM_chunk takeThreadStackChunk(
+  GC_state s,
+  HM_chunkList list,
+  size_t bytesRequested);
+
 #endif /* (defined (MLTON_GC_INTERNAL_FUNCS)) */
 
 #endif /* THREAD_H_ */
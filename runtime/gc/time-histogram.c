@@ -49,6 +49,28 @@ void TimeHistogram_insert(TimeHistogram h, struct timespec *elem) {
 }
 
 
+uintmax_t TimeHistogram_percentileUs(TimeHistogram h, double q) {
+  size_t total = 0;
+  for (size_t i = 0; i < h->numBuckets; i++) {
+    total += h->buckets[i];
+  }
+
+  size_t rank = (size_t)(q * (double)total);
+  size_t seen = 0;
+  size_t edge = 0;
+  for (size_t i = 0; i < h->numBuckets && total > 0; i++) {
+    seen += h->buckets[i];
+    if (seen > rank) {
+      edge = (i + 1 < h->numBuckets) ? i + 1 : i;
+      break;
+    }
+  }
+
+  return (uintmax_t)edge * ((uintmax_t)h->bucketWidth.tv_sec * 1000000
+                            + (uintmax_t)h->bucketWidth.tv_nsec / 1000);
+}
+
+
 size_t TimeHistogram_reportDistribution(TimeHistogram h, double *output) {
   size_t total = 0;
   for (size_t i = 0; i < h->numBuckets; i++) {
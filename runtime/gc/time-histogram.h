@@ -43,6 +43,11 @@ size_t TimeHistogram_reportDistribution(TimeHistogram h, double *output);
 
 void TimeHistogram_insert(TimeHistogram th, struct timespec *elem);
 
+// upper edge, in microseconds, of the bucket containing the q-quantile
+// (0 <= q <= 1) of the inserted elements. the last bucket is open-ended, so
+// its lower edge is returned instead.
+uintmax_t TimeHistogram_percentileUs(TimeHistogram h, double q);
+
 #endif
 
 #endif /* TIME_HISTOGRAM_H_ */
\ No newline at end of file
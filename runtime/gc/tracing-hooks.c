@@ -6,44 +6,164 @@
 
 #include "tracing-hooks.h"
 
+#if (defined (MLTON_GC_INTERNAL_FUNCS))
+
+static inline void traceLongEnter(GC_state s, EventInt *start, int kind) {
+#ifdef ENABLE_TRACING
+  (void)start;
+  Trace0(kind);
+#else
+  (void)kind;
+  if (s->trace != NULL)
+    *start = TracingNow();
+#endif
+}
+
+static inline bool traceLongLeave(GC_state s, EventInt start,
+                                  int enterKind, int leaveKind) {
+#ifdef ENABLE_TRACING
+  (void)start;
+  (void)enterKind;
+  Trace0(leaveKind);
+  return TRUE;
+#else
+  if (s->trace == NULL)
+    return FALSE;
+
+  struct timespec *threshold = &(s->controls->traceSampleThreshold);
+  EventInt now = TracingNow();
+  if (now - start >= (EventInt)threshold->tv_sec * 1000000000ULL
+                     + (EventInt)threshold->tv_nsec) {
+    TraceAt_(s->trace, start, enterKind, 0, 0, 0);
+    TraceAt_(s->trace, now, leaveKind, 0, 0, 0);
+    return TRUE;
+  }
+  return FALSE;
+#endif
+}
+
+static inline void traceHeapOccupancy(GC_state s) {
+#ifndef ENABLE_TRACING
+  if (s->trace == NULL)
+    return;
+#endif
+
+  size_t mapped;
+  size_t globalMapped;
+  size_t released;
+  size_t globalReleased;
+  size_t allocated[NUM_BLOCK_PURPOSES];
+  size_t freed[NUM_BLOCK_PURPOSES];
+  queryCurrentBlockUsage(
+    s,
+    &mapped,
+    &globalMapped,
+    &released,
+    &globalReleased,
+    allocated,
+    freed);
+
+  size_t inUse = 0;
+  for (enum BlockPurpose p = 0; p < NUM_BLOCK_PURPOSES; p++) {
+    if (allocated[p] > freed[p])
+      inUse += allocated[p] - freed[p];
+  }
+  size_t size = (released > mapped) ? 0 : mapped - released;
+
+  Trace_(s->trace, EVENT_HEAP_OCCUPANCY,
+         (EventInt)(size * s->controls->blockSize),
+         (EventInt)(inUse * s->controls->blockSize),
+         0);
+}
+
+#endif /* (defined (MLTON_GC_INTERNAL_FUNCS)) */
+
 #if (defined (MLTON_GC_INTERNAL_BASIS))
 
-void GC_Trace_schedIdleEnter(ARG_USED_FOR_TRACING GC_state s) {
-  Trace0(EVENT_SCHED_IDLE_ENTER);
+/* Scheduler events are frequent. In sampled mode (without ENABLE_TRACING),
+ * only one in every trace-sample-rate of them is recorded; for _ENTER/_LEAVE
+ * pairs, the decision is made on enter and remembered until the leave. */
+
+#ifndef ENABLE_TRACING
+static inline bool traceSampleNext(GC_state s) {
+  if (s->trace == NULL)
+    return FALSE;
+  if (s->traceSample.skip > 0) {
+    s->traceSample.skip--;
+    return FALSE;
+  }
+  s->traceSample.skip = s->controls->traceSampleRate - 1;
+  return TRUE;
 }
+#endif
 
-void GC_Trace_schedIdleLeave(ARG_USED_FOR_TRACING GC_state s) {
-  Trace0(EVENT_SCHED_IDLE_LEAVE);
+static inline void traceSampledEnter(GC_state s, int kind) {
+#ifdef ENABLE_TRACING
+  Trace0(kind);
+#else
+  if (traceSampleNext(s)) {
+    s->traceSample.open |= (uint64_t)1 << kind;
+    Trace_(s->trace, kind, 0, 0, 0);
+  }
+#endif
 }
 
-void GC_Trace_schedWorkEnter(ARG_USED_FOR_TRACING GC_state s) {
-  Trace0(EVENT_SCHED_WORK_ENTER);
+static inline void traceSampledLeave(GC_state s, int enterKind, int leaveKind) {
+#ifdef ENABLE_TRACING
+  (void)enterKind;
+  Trace0(leaveKind);
+#else
+  uint64_t bit = (uint64_t)1 << enterKind;
+  if (s->traceSample.open & bit) {
+    s->traceSample.open &= ~bit;
+    Trace_(s->trace, leaveKind, 0, 0, 0);
+  }
+#endif
 }
 
-void GC_Trace_schedWorkLeave(ARG_USED_FOR_TRACING GC_state s) {
-  Trace0(EVENT_SCHED_WORK_LEAVE);
+static inline void traceSampledInstant(GC_state s, int kind) {
+#ifdef ENABLE_TRACING
+  Trace0(kind);
+#else
+  if (traceSampleNext(s))
+    Trace_(s->trace, kind, 0, 0, 0);
+#endif
 }
 
-void GC_Trace_schedSleepEnter(ARG_USED_FOR_TRACING GC_state s) {
-  Trace0(EVENT_SCHED_SLEEP_ENTER);
+void GC_Trace_schedIdleEnter(GC_state s) {
+  traceSampledEnter(s, EVENT_SCHED_IDLE_ENTER);
 }
 
-void GC_Trace_schedSleepLeave(ARG_USED_FOR_TRACING GC_state s) {
-  Trace0(EVENT_SCHED_SLEEP_LEAVE);
+void GC_Trace_schedIdleLeave(GC_state s) {
+  traceSampledLeave(s, EVENT_SCHED_IDLE_ENTER, EVENT_SCHED_IDLE_LEAVE);
 }
 
-void GC_Trace_schedSpawn(ARG_USED_FOR_TRACING GC_state s) {
-  Trace0(EVENT_SCHED_SPAWN);
+void GC_Trace_schedWorkEnter(GC_state s) {
+  traceSampledEnter(s, EVENT_SCHED_WORK_ENTER);
 }
 
-void GC_Trace_schedJoin(ARG_USED_FOR_TRACING GC_state s) {
-  Trace0(EVENT_SCHED_JOIN);
+void GC_Trace_schedWorkLeave(GC_state s) {
+  traceSampledLeave(s, EVENT_SCHED_WORK_ENTER, EVENT_SCHED_WORK_LEAVE);
 }
 
-void GC_Trace_schedJoinFast(ARG_USED_FOR_TRACING GC_state s) {
-  Trace0(EVENT_SCHED_JOINFAST);
+void GC_Trace_schedSleepEnter(GC_state s) {
+  traceSampledEnter(s, EVENT_SCHED_SLEEP_ENTER);
 }
 
+void GC_Trace_schedSleepLeave(GC_state s) {
+  traceSampledLeave(s, EVENT_SCHED_SLEEP_ENTER, EVENT_SCHED_SLEEP_LEAVE);
+}
 
+void GC_Trace_schedSpawn(GC_state s) {
+  traceSampledInstant(s, EVENT_SCHED_SPAWN);
+}
+
+void GC_Trace_schedJoin(GC_state s) {
+  traceSampledInstant(s, EVENT_SCHED_JOIN);
+}
+
+void GC_Trace_schedJoinFast(GC_state s) {
+  traceSampledInstant(s, EVENT_SCHED_JOINFAST);
+}
 
-#endif
\ No newline at end of file
+#endif
@@ -7,6 +7,21 @@
 #ifndef TRACING_HOOKS_H_
 #define TRACING_HOOKS_H_
 
+#if (defined (MLTON_GC_INTERNAL_FUNCS))
+
+/* Long-running phases (LGC, CGC). With ENABLE_TRACING these are always
+ * traced. Otherwise, in sampled mode, the start time is saved in *start and
+ * the phase is traced on leave only if it took at least
+ * trace-sample-threshold. traceLongLeave returns whether it was traced. */
+static inline void traceLongEnter(GC_state s, EventInt *start, int kind);
+static inline bool traceLongLeave(GC_state s, EventInt start,
+                                  int enterKind, int leaveKind);
+
+/* Record EVENT_HEAP_OCCUPANCY: the bytes of blocks mapped (size) and in
+ * use (allocated), across all processors. */
+static inline void traceHeapOccupancy(GC_state s);
+
+#endif /* (defined (MLTON_GC_INTERNAL_FUNCS)) */
 
 #if (defined (MLTON_GC_INTERNAL_BASIS))
 
@@ -26,4 +41,4 @@ PRIVATE void GC_Trace_schedJoinFast(GC_state s);
 #endif // defined(MLTON_GC_INTERNAL_BASIS)
 
 
-#endif
\ No newline at end of file
+#endif
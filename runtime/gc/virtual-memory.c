@@ -7,6 +7,10 @@
  * See the file MLton-LICENSE for details.
  */
 
+#if HAS_NONTEMPORAL_COPY && defined (__SSE2__)
+#include <emmintrin.h>
+#endif
+
 void *GC_mmapAnonFlags_safe (void *p, size_t length, int flags) {
   void *result;
 
@@ -32,10 +36,104 @@ static inline void GC_memcpy (pointer src, pointer dst, size_t size) {
   memcpy (dst, src, size);
 }
 
+/* Copy an object that the collector is moving. Most copied objects are
+ * small tuples and list cells, for which a call to memcpy costs more than
+ * the copy itself, so sizes of up to 8 words are copied with fixed-size
+ * moves that the compiler inlines. */
+static inline void GC_memcpyObject (pointer src, pointer dst, size_t size) {
+  assert (! (src <= dst and dst < src + size));
+  assert (! (dst <= src and src < dst + size));
+
+  switch (size) {
+#define COPY_WORDS(n) \
+  case (n) * sizeof(uintptr_t): \
+    memcpy (dst, src, (n) * sizeof(uintptr_t)); \
+    return;
+  COPY_WORDS(1)
+  COPY_WORDS(2)
+  COPY_WORDS(3)
+  COPY_WORDS(4)
+  COPY_WORDS(5)
+  COPY_WORDS(6)
+  COPY_WORDS(7)
+  COPY_WORDS(8)
+#undef COPY_WORDS
+  default:
+    GC_memcpy (src, dst, size);
+  }
+}
+
+/* Copy with stores that bypass the cache, for large objects that the
+ * collector will not read again (i.e., without objptrs). Falls back to
+ * GC_memcpy on targets without HAS_NONTEMPORAL_COPY. */
+static inline void GC_memcpyNonTemporal (pointer src, pointer dst, size_t size) {
+#if HAS_NONTEMPORAL_COPY && defined (__SSE2__)
+  assert (! (src <= dst and dst < src + size));
+  assert (! (dst <= src and src < dst + size));
+
+  size_t head = (size_t)(align ((uintptr_t)dst, 16) - (uintptr_t)dst);
+  if (size < head + 16) {
+    memcpy (dst, src, size);
+    return;
+  }
+  memcpy (dst, src, head);
+  src += head;
+  dst += head;
+  size -= head;
+
+  size_t body = size & ~(size_t)15;
+  for (size_t i = 0; i < body; i += 16) {
+    __m128i x = _mm_loadu_si128 ((const __m128i *)(src + i));
+    _mm_stream_si128 ((__m128i *)(dst + i), x);
+  }
+  memcpy (dst + body, src + body, size - body);
+  /* order the streaming stores before e.g. installing a forwarding ptr */
+  _mm_sfence ();
+#else
+  GC_memcpy (src, dst, size);
+#endif
+}
+
 void GC_memcpyToBuffer(pointer src, pointer buffer, size_t offset, size_t length) {
   GC_memcpy(src, buffer + offset, length);
 }
 
+size_t GC_memchrIndex(pointer buffer, size_t start, size_t end, Word8_t c) {
+  pointer p = memchr(buffer + start, c, end - start);
+  return (NULL == p) ? end : (size_t)(p - buffer);
+}
+
+Int32_t GC_memCompare(pointer a, size_t ai, pointer b, size_t bi, size_t n) {
+  int c = memcmp(a + ai, b + bi, n);
+  return (c > 0) - (c < 0);
+}
+
+ssize_t GC_memFind(
+  pointer hay, size_t start, size_t end,
+  pointer needle, size_t ni, size_t n)
+{
+  if (0 == n)
+    return (ssize_t)start;
+  if (end - start < n)
+    return -1;
+
+  pointer first = needle + ni;
+  pointer last = hay + end - n;
+  /* memchr finds the candidates; it is vectorized in any reasonable libc. */
+  for (pointer p = hay + start; p <= last; p++) {
+    p = memchr(p, *first, (size_t)(last - p) + 1);
+    if (NULL == p)
+      return -1;
+    if (0 == memcmp(p + 1, first + 1, n - 1))
+      return (ssize_t)(p - hay);
+  }
+  return -1;
+}
+
+void GC_memcpyFromBuffer(pointer buffer, size_t offset, pointer dst, size_t length) {
+  GC_memcpy(buffer + offset, dst, length);
+}
+
 static inline void GC_memmove (pointer src, pointer dst, size_t size) {
   if (DEBUG_DETAILED)
     fprintf (stderr, "GC_memmove ("FMTPTR", "FMTPTR", %"PRIuMAX")\n",
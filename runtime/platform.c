@@ -35,6 +35,9 @@ void MLton_halt (GC_state s, C_Int_t status) {
    * need to flush our trace buffer manually. */
   GC_traceFinish(s);
 
+  /* Remove the metrics socket, if any. */
+  GC_metricsFinish(s);
+
   exit (status);
 }
 
@@ -42,3 +45,91 @@ void MLton_heapCheckTooLarge (void) {
   die ("Out of memory.  Unable to check heap for more than %"PRIuMAX" bytes.\n",
        (uintmax_t)SIZE_MAX);
 }
+
+#if HAS_EPOLL
+
+int GC_pollerCreate (void) {
+  return epoll_create1 (EPOLL_CLOEXEC);
+}
+
+int GC_pollerArm (int pollfd, int fd, int events, int token) {
+  struct epoll_event ev;
+
+  ev.events = EPOLLONESHOT;
+  if (events & GC_POLLER_READABLE)
+    ev.events |= EPOLLIN | EPOLLRDHUP;
+  if (events & GC_POLLER_WRITABLE)
+    ev.events |= EPOLLOUT;
+  /* GC_pollerTake needs the descriptor to remove it again. */
+  ev.data.u64 = ((uint64_t)(uint32_t)fd << 32) | (uint64_t)(uint32_t)token;
+
+  /* A descriptor is registered for as long as it has a waiter, so ADD
+   * fails with EEXIST for a second waiter rather than overwriting the
+   * first one's registration. */
+  if (0 == epoll_ctl (pollfd, EPOLL_CTL_ADD, fd, &ev))
+    return 0;
+  if (errno == EPERM)
+    return 1;
+  return -1;
+}
+
+int GC_pollerTake (int pollfd, int *token) {
+  struct epoll_event ev;
+  int res;
+
+  res = epoll_wait (pollfd, &ev, 1, 0);
+  if (res == -1 && errno == EINTR)
+    return 0;
+  if (res == 1) {
+    /* The one-shot registration is disabled now; remove it so that the
+     * descriptor can be armed for its next waiter. This fails harmlessly
+     * if the descriptor has been closed in the meantime. */
+    int fd = (int)(uint32_t)(ev.data.u64 >> 32);
+    epoll_ctl (pollfd, EPOLL_CTL_DEL, fd, &ev);
+    *token = (int)(uint32_t)ev.data.u64;
+  }
+  return res;
+}
+
+#else
+
+int GC_pollerCreate (void) {
+  errno = ENOSYS;
+  return -1;
+}
+
+int GC_pollerArm (__attribute__ ((unused)) int pollfd,
+                  __attribute__ ((unused)) int fd,
+                  __attribute__ ((unused)) int events,
+                  __attribute__ ((unused)) int token) {
+  errno = ENOSYS;
+  return -1;
+}
+
+int GC_pollerTake (__attribute__ ((unused)) int pollfd,
+                   __attribute__ ((unused)) int *token) {
+  errno = ENOSYS;
+  return -1;
+}
+
+#endif
+
+void GC_pollerBlock (int fd, int events) {
+#ifdef POLLIN
+  struct pollfd pfd;
+
+  pfd.fd = fd;
+  pfd.events = 0;
+  if (events & GC_POLLER_READABLE)
+    pfd.events |= POLLIN;
+  if (events & GC_POLLER_WRITABLE)
+    pfd.events |= POLLOUT;
+  /* Heartbeat signals interrupt the wait. */
+  while (-1 == poll (&pfd, 1, -1) && errno == EINTR)
+    ;
+#else
+  /* No way to wait here; the caller's I/O operation will block instead. */
+  (void)fd;
+  (void)events;
+#endif
+}
@@ -59,6 +59,14 @@
 #define EXECVP execvp
 #endif
 
+#ifndef HAS_NONTEMPORAL_COPY
+#define HAS_NONTEMPORAL_COPY FALSE
+#endif
+
+#ifndef HAS_EPOLL
+#define HAS_EPOLL FALSE
+#endif
+
 #ifndef EXECVE
 #define EXECVE execve
 #endif
@@ -92,6 +100,8 @@
 #define FE_TOWARDZERO 3
 #endif
 
+#include "tracing.h"
+
 #include "gc.h"
 
 #ifndef INLINE
@@ -99,8 +109,6 @@
 #endif
 #include "basis-ffi.h"
 
-#include "tracing.h"
-
 /* ---------------------------------------------------------------- */
 /*                        Runtime Init/Exit/Alloc                   */
 /* ---------------------------------------------------------------- */
@@ -127,8 +135,40 @@ PRIVATE __attribute__ ((noreturn)) void MLton_heapCheckTooLarge (void);
 PRIVATE void GC_displayMem (void);
 
 PRIVATE void GC_memcpyToBuffer(pointer src, pointer buffer, size_t offset, size_t length);
+/* The index of the first c in buffer[start, end), or end if there is none. */
+PRIVATE size_t GC_memchrIndex(pointer buffer, size_t start, size_t end, Word8_t c);
+/* The sign of memcmp(a+ai, b+bi, n). */
+PRIVATE Int32_t GC_memCompare(pointer a, size_t ai, pointer b, size_t bi, size_t n);
+/* The index of the first occurrence of needle[ni, ni+n) in hay[start, end),
+ * or -1 if there is none. */
+PRIVATE ssize_t GC_memFind(pointer hay, size_t start, size_t end, pointer needle, size_t ni, size_t n);
+PRIVATE void GC_memcpyFromBuffer(pointer buffer, size_t offset, pointer dst, size_t length);
 
 PRIVATE void *GC_mmapFileReadable (int fd, size_t size);
+/* Like GC_mmapFileReadable, but the whole file is read in before returning
+ * (MAP_POPULATE), where the platform supports it. */
+PRIVATE void *GC_mmapFileReadablePopulate (int fd, size_t size);
+
+/* Map a file opened for reading and writing, shared, so that stores reach
+ * the file. Returns NULL on failure. */
+PRIVATE void *GC_mmapFileWritable (int fd, size_t size);
+/* Write back [base, base+length) of a GC_mmapFileWritable mapping, waiting
+ * for completion. Returns 0, or -errno on failure. */
+PRIVATE int GC_msync (void *base, size_t length);
+
+/* Access-pattern hints for file mappings, passed to GC_adviseMapping. */
+#define GC_ADVICE_NORMAL 0
+#define GC_ADVICE_SEQUENTIAL 1
+#define GC_ADVICE_RANDOM 2
+#define GC_ADVICE_WILLNEED 3
+#define GC_ADVICE_DONTNEED 4
+
+/* Hint (posix_madvise) how [base, base+length) will be accessed; the range
+ * is widened to page boundaries. Returns 0, or -errno on failure. */
+PRIVATE int GC_adviseMapping (void *base, size_t length, int advice);
+/* Read one byte of each page of [base, base+length), so that the pages are
+ * faulted in by the calling thread. */
+PRIVATE void GC_prefaultMapping (void *base, size_t length);
 PRIVATE void *GC_mmapAnon (void *start, size_t length);
 PRIVATE void *GC_mmapAnonFlags (void *start, size_t length, int flags);
 PRIVATE void *GC_mmapAnon_safe (void *start, size_t length);
@@ -191,4 +231,31 @@ PRIVATE int MLton_recv(int s, void *buf, int len, int flags);
 PRIVATE int MLton_recvfrom(int s, void *buf, int len, int flags, void *from, socklen_t *fromlen);
 #endif
 
+/* ------------------------------------------------- */
+/*                  I/O readiness                    */
+/* ------------------------------------------------- */
+
+/* Readiness notification for the scheduler (see MkScheduler.sml). A poller
+ * is an epoll instance; each armed descriptor reports at most once (it is
+ * one-shot) and carries an integer token chosen by the caller. A descriptor
+ * has at most one waiter at a time: it stays armed until its report is
+ * taken. Without HAS_EPOLL, GC_pollerCreate fails with ENOSYS and only
+ * GC_pollerBlock is available.
+ */
+#define GC_POLLER_READABLE 0x1
+#define GC_POLLER_WRITABLE 0x2
+
+/* Returns a poller descriptor, or -1 (with errno set). */
+PRIVATE int GC_pollerCreate (void);
+/* Arms fd in the poller for the given events. Returns 0 if armed, 1 if fd
+ * never blocks (a regular file), or -1 (with errno set, e.g. EEXIST if fd
+ * already has a waiter), in which case the caller should use
+ * GC_pollerBlock instead. */
+PRIVATE int GC_pollerArm (int pollfd, int fd, int events, int token);
+/* Takes one ready token without blocking. Returns 1 and sets *token, or 0
+ * if nothing is ready, or -1 (with errno set). */
+PRIVATE int GC_pollerTake (int pollfd, int *token);
+/* Blocks the calling thread until fd is ready for the given events. */
+PRIVATE void GC_pollerBlock (int fd, int events);
+
 #endif /* _MLTON_PLATFORM_H_ */
@@ -1,5 +1,9 @@
 #define MLton_Platform_Arch_host "amd64"
 
+/* SSE2 is part of the base ISA, so the GC may copy large pointer-free
+ * objects with non-temporal stores (see GC_memcpyNonTemporal). */
+#define HAS_NONTEMPORAL_COPY TRUE
+
 #define POINTER_BITS 64
 #if (defined (__CYGWIN__) || defined (__MINGW32__))
 #define ADDRESS_BITS 43
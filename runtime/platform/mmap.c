@@ -1,5 +1,13 @@
+static inline void *mmapFileReadableFlags (int fd, size_t size, int flags) {
+  return mmap (0, size, PROT_READ, MAP_PRIVATE | flags, fd, 0);
+}
+
 static inline void *mmapFileReadable (int fd, size_t size) {
-  return mmap (0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  return mmapFileReadableFlags (fd, size, 0);
+}
+
+static inline void *mmapFileWritable (int fd, size_t size) {
+  return mmap (0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
 }
 
 static inline void *mmapAnonFlags (void *start, size_t length, int flags) {
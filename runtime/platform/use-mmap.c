@@ -8,6 +8,59 @@ void *GC_mmapFileReadable (int fd, size_t size) {
   return mmapFileReadable(fd, size);
 }
 
+void *GC_mmapFileReadablePopulate (int fd, size_t size) {
+#ifdef MAP_POPULATE
+  return mmapFileReadableFlags(fd, size, MAP_POPULATE);
+#else
+  /* No way to fault the mapping in eagerly; at least start the reads. */
+  void *p = mmapFileReadable(fd, size);
+  if (p != MAP_FAILED)
+    GC_adviseMapping(p, size, GC_ADVICE_WILLNEED);
+  return p;
+#endif
+}
+
+void *GC_mmapFileWritable (int fd, size_t size) {
+  void *p = mmapFileWritable(fd, size);
+  return (p == MAP_FAILED) ? NULL : p;
+}
+
+int GC_msync (void *base, size_t length) {
+  if (0 == length)
+    return 0;
+  return (0 == msync (base, length, MS_SYNC)) ? 0 : -errno;
+}
+
+int GC_adviseMapping (void *base, size_t length, int advice) {
+  static const int posixAdvice[] = {
+    [GC_ADVICE_NORMAL] = POSIX_MADV_NORMAL,
+    [GC_ADVICE_SEQUENTIAL] = POSIX_MADV_SEQUENTIAL,
+    [GC_ADVICE_RANDOM] = POSIX_MADV_RANDOM,
+    [GC_ADVICE_WILLNEED] = POSIX_MADV_WILLNEED,
+    [GC_ADVICE_DONTNEED] = POSIX_MADV_DONTNEED,
+  };
+  size_t ps = GC_pageSize ();
+  uintptr_t lo = alignDown ((uintptr_t)base, ps);
+  uintptr_t hi = (uintptr_t)base + length;
+
+  if (advice < 0 || advice > GC_ADVICE_DONTNEED)
+    return -EINVAL;
+  if (0 == length)
+    return 0;
+  /* posix_madvise returns the error rather than setting errno. */
+  return -posix_madvise ((void *)lo, hi - lo, posixAdvice[advice]);
+}
+
+void GC_prefaultMapping (void *base, size_t length) {
+  size_t ps = GC_pageSize ();
+  uintptr_t hi = (uintptr_t)base + length;
+
+  if (0 == length)
+    return;
+  for (uintptr_t p = alignDown ((uintptr_t)base, ps); p < hi; p += ps)
+    (void)*(volatile char *)p;
+}
+
 void *GC_mmapAnon (void *start, size_t length) {
         return mmapAnon (start, length);
 }
@@ -81,7 +81,9 @@ enum EventKind {
   EVENT_MANAGE_ENTANGLED_LEAVE = 47,
 
   EVENT_SCHED_SLEEP_ENTER     = 48,
-  EVENT_SCHED_SLEEP_LEAVE     = 49
+  EVENT_SCHED_SLEEP_LEAVE     = 49,
+
+  EVENT_TRACE_DROPPED         = 50
 };
 
 #define EventKindCount (sizeof EventKindStrings / sizeof *EventKindStrings)
@@ -103,10 +105,95 @@ struct Event {
   EventInt arg3;
 };
 
-struct TraceFileHeader {
-  EventInt version;
-};
+/* Number of arguments recorded for each kind of event in the compact format.
+ * Kinds not listed here (including user kinds) keep all three. */
+static inline unsigned int EventKindArity(int kind) {
+  switch (kind) {
+  case EVENT_NIL:
+  case EVENT_INIT:
+  case EVENT_LAUNCH:
+  case EVENT_FINISH:
+  case EVENT_RUNTIME_ENTER:
+  case EVENT_RUNTIME_LEAVE:
+  case EVENT_LGC_ENTER:
+  case EVENT_LGC_LEAVE:
+  case EVENT_LGC_ABORT:
+  case EVENT_HALT_REQ:
+  case EVENT_HALT_WAIT:
+  case EVENT_HALT_ACK:
+  case EVENT_GSECTION_BEGIN_ENTER:
+  case EVENT_GSECTION_BEGIN_LEAVE:
+  case EVENT_GSECTION_END_ENTER:
+  case EVENT_GSECTION_END_LEAVE:
+  case EVENT_ARRAY_ALLOCATE_LEAVE:
+  case EVENT_PROMOTION_LEAVE:
+  case EVENT_SCHED_IDLE_ENTER:
+  case EVENT_SCHED_IDLE_LEAVE:
+  case EVENT_SCHED_WORK_ENTER:
+  case EVENT_SCHED_WORK_LEAVE:
+  case EVENT_HEARTBEAT_RECEIVED:
+  case EVENT_HANDLER_ENTER:
+  case EVENT_HANDLER_LEAVE:
+  case EVENT_SCHED_SPAWN:
+  case EVENT_SCHED_JOIN:
+  case EVENT_SCHED_JOINFAST:
+  case EVENT_CGC_ENTER:
+  case EVENT_CGC_LEAVE:
+  case EVENT_MANAGE_ENTANGLED_ENTER:
+  case EVENT_MANAGE_ENTANGLED_LEAVE:
+  case EVENT_SCHED_SLEEP_ENTER:
+  case EVENT_SCHED_SLEEP_LEAVE:
+    return 0;
+
+  case EVENT_LOCK_TAKE_ENTER:
+  case EVENT_LOCK_TAKE_LEAVE:
+  case EVENT_RWLOCK_W_TAKE:
+  case EVENT_RWLOCK_W_RELEASE:
+  case EVENT_TRACE_DROPPED:
+    return 1;
+
+  case EVENT_THREAD_COPY:
+  case EVENT_HEAP_OCCUPANCY:
+  case EVENT_CHUNKP_OCCUPANCY:
+  case EVENT_RWLOCK_R_TAKE:
+  case EVENT_RWLOCK_R_RELEASE:
+  case EVENT_PROMOTION_ENTER:
+  case EVENT_PROMOTED_WRITE:
+  case EVENT_PROMOTION:
+  case EVENT_MERGED_HEAP:
+    return 2;
+
+  default:
+    return 3;
+  }
+}
+
+/* Trace files written before TraceCurrentVersion (TraceLegacyVersion) are a
+ * bare sequence of struct Event, which always start with a non-zero kind.
+ *
+ * In the current version, a trace is a sequence of records, each a list of
+ * LEB128 varints:
+ *
+ *   kind, nanoseconds since the previous record, arg1 .. argN
+ *
+ * where N is EventKindArity(kind). EVENT_NIL is never recorded; instead it
+ * introduces a header record
+ *
+ *   EVENT_NIL, version, processor number
+ *
+ * which also resets the time of the previous record to 0. The runtime starts
+ * every buffer with a header, so that per-processor files can be concatenated
+ * and a buffer recovered from a core dump can be decoded on its own. */
+#define TraceLegacyVersion 0x20170419ULL
+#define TraceCurrentVersion 0x20261018ULL
+
+/* Bytes needed to encode an EventInt as a varint. */
+#define TraceVarintMaxSize 10
+
+/* Upper bound on the size of one record in the current version. */
+#define TraceRecordMaxSize (5 * TraceVarintMaxSize)
 
-#define TraceCurrentVersion 0x20170419ULL
+/* Upper bound on the size of a header record. */
+#define TraceHeaderMaxSize (3 * TraceVarintMaxSize)
 
 #endif  /* TRACE_H */
@@ -7,12 +7,189 @@
 #include <sys/time.h>
 
 #include <assert.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 
 #include "tracing.h"
 
+/* How long the writer thread sleeps when it finds nothing to do. Wakeups are
+ * sent without holding TracingWriterLock (so that Trace() never blocks), which
+ * means one can occasionally be missed; the timeout bounds the delay. */
+#define TRACING_WRITER_PERIOD_NS 10000000L
+
+static pthread_once_t TracingWriterOnce = PTHREAD_ONCE_INIT;
+static pthread_mutex_t TracingWriterLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t TracingWriterCond = PTHREAD_COND_INITIALIZER;
+/* Contexts drained by the writer thread. Protected by TracingWriterLock. */
+static struct TracingContext *TracingContexts = NULL;
+
+static void TracingWriteBytes(struct TracingContext *ctx,
+                              const void *bytes,
+                              size_t nbytes) {
+  if (fwrite(bytes, 1, nbytes, ctx->file) < nbytes) {
+    fprintf(stderr, "Tracing: could not write to file\n");
+    exit(1);
+  }
+}
+
+/* Write out and release a buffer handed off by the owner of ctx, if any.
+ * Must be called with TracingWriterLock held. */
+static bool TracingDrainBuffer(struct TracingContext *ctx, size_t b) {
+  size_t nbytes = __atomic_load_n(&ctx->pending[b], __ATOMIC_ACQUIRE);
+
+  if (nbytes == 0)
+    return false;
+
+  TracingWriteBytes(ctx, ctx->buffers[b], nbytes);
+  __atomic_store_n(&ctx->pending[b], 0, __ATOMIC_RELEASE);
+  return true;
+}
+
+static void *TracingWriterLoop(__attribute__ ((unused)) void *arg) {
+  pthread_mutex_lock(&TracingWriterLock);
+
+  while (true) {
+    bool didWork = false;
+
+    for (struct TracingContext *ctx = TracingContexts;
+         ctx != NULL;
+         ctx = ctx->next) {
+      /* The buffer handed off first is always the one not being filled. */
+      size_t older = 1 - __atomic_load_n(&ctx->active, __ATOMIC_ACQUIRE);
+      didWork |= TracingDrainBuffer(ctx, older);
+      didWork |= TracingDrainBuffer(ctx, 1 - older);
+    }
+
+    if (didWork)
+      continue;
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_nsec += TRACING_WRITER_PERIOD_NS;
+    if (deadline.tv_nsec >= 1000000000L) {
+      deadline.tv_sec++;
+      deadline.tv_nsec -= 1000000000L;
+    }
+    pthread_cond_timedwait(&TracingWriterCond, &TracingWriterLock, &deadline);
+  }
+
+  return NULL;
+}
+
+static void TracingStartWriter(void) {
+  pthread_t writer;
+  sigset_t all, old;
+
+  /* The writer must never run signal handlers meant for the workers. */
+  sigfillset(&all);
+  pthread_sigmask(SIG_SETMASK, &all, &old);
+
+  if (pthread_create(&writer, NULL, TracingWriterLoop, NULL)) {
+    fprintf(stderr, "Tracing: could not start writer thread\n");
+    exit(1);
+  }
+  pthread_detach(writer);
+
+  pthread_sigmask(SIG_SETMASK, &old, NULL);
+}
+
+static inline EventInt
+TracingGetTime(void)
+{
+  struct timespec ts;
+
+#if defined(__APPLE__)
+  struct timeval tv;
+
+  gettimeofday(&tv, NULL);
+  ts.tv_sec = tv.tv_sec;
+  ts.tv_nsec = 1000 * tv.tv_usec;
+#elif defined(CLOCK_MONOTONIC_RAW)
+  clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+#else
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+
+  return (EventInt)ts.tv_sec * 1000000000ULL + (EventInt)ts.tv_nsec;
+}
+
+static inline uint8_t *TracingPutVarint(uint8_t *p, EventInt x) {
+  while (x >= 0x80) {
+    *p++ = (uint8_t)(x | 0x80);
+    x >>= 7;
+  }
+  *p++ = (uint8_t)x;
+  return p;
+}
+
+EventInt TracingNow(void) {
+  return TracingGetTime();
+}
+
+static inline void TracingAppend(struct TracingContext *ctx,
+                                 EventInt now, int kind,
+                                 EventInt arg1, EventInt arg2, EventInt arg3) {
+  assert(ctx->index + TraceRecordMaxSize <= ctx->capacity);
+
+  unsigned int arity = EventKindArity(kind);
+  assert(arity >= 1 || arg1 == 0);
+  assert(arity >= 2 || arg2 == 0);
+  assert(arity >= 3 || arg3 == 0);
+
+  /* The clock may step backwards where it is not monotonic, and TraceAt_ may
+   * be given a time in the past; never encode a negative delta. */
+  if (now < ctx->lastTime)
+    now = ctx->lastTime;
+
+  uint8_t *p = ctx->buffers[ctx->active] + ctx->index;
+  p = TracingPutVarint(p, (EventInt)kind);
+  p = TracingPutVarint(p, now - ctx->lastTime);
+  if (arity >= 1) p = TracingPutVarint(p, arg1);
+  if (arity >= 2) p = TracingPutVarint(p, arg2);
+  if (arity >= 3) p = TracingPutVarint(p, arg3);
+
+  ctx->lastTime = now;
+  ctx->index = p - ctx->buffers[ctx->active];
+}
+
+/* Whether the active buffer may not have room for another record. */
+static inline bool TracingIsFull(struct TracingContext *ctx) {
+  return ctx->index + TraceRecordMaxSize > ctx->capacity;
+}
+
+/* Start filling a fresh buffer, reporting any events dropped while we were
+ * waiting for one. */
+static inline void TracingResume(struct TracingContext *ctx) {
+  uint8_t *p = ctx->buffers[ctx->active];
+  p = TracingPutVarint(p, EVENT_NIL);
+  p = TracingPutVarint(p, TraceCurrentVersion);
+  p = TracingPutVarint(p, ctx->id);
+  ctx->index = p - ctx->buffers[ctx->active];
+  ctx->lastTime = 0;
+
+  if (ctx->dropped > 0) {
+    TracingAppend(ctx, TracingGetTime(), EVENT_TRACE_DROPPED, ctx->dropped, 0, 0);
+    ctx->dropped = 0;
+  }
+}
+
+/* Try to switch to the other buffer. Fails (leaving the context full) if the
+ * writer has not released it yet. */
+static inline bool TracingTrySwitch(struct TracingContext *ctx) {
+  size_t other = 1 - ctx->active;
+
+  if (__atomic_load_n(&ctx->pending[other], __ATOMIC_ACQUIRE) != 0)
+    return false;
+
+  __atomic_store_n(&ctx->active, other, __ATOMIC_RELEASE);
+  TracingResume(ctx);
+  return true;
+}
+
 struct TracingContext *TracingNewContext(const char *filename,
                                          size_t bufferCapacity,
                                          uint32_t procNumber) {
@@ -23,9 +200,16 @@ struct TracingContext *TracingNewContext(const char *filename,
     exit(1);
   }
 
-  if ((ctx->buffer = calloc(bufferCapacity, sizeof *ctx->buffer)) == NULL) {
-    fprintf(stderr, "Tracing: could not allocate buffer\n");
-    exit(1);
+  /* Leave room for the header and EVENT_TRACE_DROPPED at the start of each
+   * buffer. */
+  size_t capacity = TraceHeaderMaxSize + (bufferCapacity + 1) * TraceRecordMaxSize;
+
+  for (size_t b = 0; b < 2; b++) {
+    if ((ctx->buffers[b] = malloc(capacity)) == NULL) {
+      fprintf(stderr, "Tracing: could not allocate buffer\n");
+      exit(1);
+    }
+    ctx->pending[b] = 0;
   }
 
   if ((ctx->file = fopen(filename, "wb")) == NULL) {
@@ -34,11 +218,19 @@ struct TracingContext *TracingNewContext(const char *filename,
   }
 
   ctx->id = procNumber;
-  ctx->capacity = bufferCapacity;
-  ctx->index = 0;
+  ctx->capacity = capacity;
+  ctx->active = 0;
+  ctx->dropped = 0;
+  TracingResume(ctx);
 
   Trace_(ctx, EVENT_INIT, 0, 0, 0);
 
+  pthread_once(&TracingWriterOnce, TracingStartWriter);
+  pthread_mutex_lock(&TracingWriterLock);
+  ctx->next = TracingContexts;
+  TracingContexts = ctx;
+  pthread_mutex_unlock(&TracingWriterLock);
+
   return ctx;
 }
 
@@ -46,13 +238,25 @@ void TracingCloseAndFreeContext(struct TracingContext **ctx) {
   if (*ctx == NULL)
     return;
 
+  /* Flush first, so that there is room for the termination event even if
+   * the writer had fallen behind. */
+  TracingFlushBuffer(*ctx);
+
   /* Mark termination in the log file. */
   Trace_(*ctx, EVENT_FINISH, 0, 0, 0);
 
+  pthread_mutex_lock(&TracingWriterLock);
+  struct TracingContext **link = &TracingContexts;
+  while (*link != *ctx)
+    link = &(*link)->next;
+  *link = (*ctx)->next;
+  pthread_mutex_unlock(&TracingWriterLock);
+
   TracingFlushBuffer(*ctx);
 
   fclose((*ctx)->file);
-  free((*ctx)->buffer);
+  free((*ctx)->buffers[0]);
+  free((*ctx)->buffers[1]);
   free(*ctx);
   *ctx = NULL;
 }
@@ -62,48 +266,43 @@ void TracingFlushBuffer(struct TracingContext *ctx) {
   assert(ctx->file);
   assert(ctx->index <= ctx->capacity);
 
-  size_t nitems = ctx->index;
+  pthread_mutex_lock(&TracingWriterLock);
 
-  if (fwrite(ctx->buffer, sizeof *ctx->buffer, nitems, ctx->file) < nitems) {
-    fprintf(stderr, "Tracing: could not write to file\n");
-    exit(1);
-  }
+  /* Oldest first: see TracingWriterLoop. If the active buffer is pending,
+   * its contents are the pending bytes. */
+  TracingDrainBuffer(ctx, 1 - ctx->active);
+  if (!TracingDrainBuffer(ctx, ctx->active))
+    TracingWriteBytes(ctx, ctx->buffers[ctx->active], ctx->index);
+  TracingResume(ctx);
 
-  ctx->index = 0;
+  pthread_mutex_unlock(&TracingWriterLock);
 }
 
-static inline void
-TracingGetTimespec(struct timespec *ts)
-{
-#if defined(__APPLE__)
-  struct timeval tv;
+void Trace_(struct TracingContext *ctx, int kind,
+            EventInt arg1, EventInt arg2, EventInt arg3) {
+  if (!ctx)
+    return;
 
-  gettimeofday(&tv, NULL);
-  ts->tv_sec = tv.tv_sec;
-  ts->tv_nsec = 1000 * tv.tv_usec;
-#elif defined(CLOCK_MONOTONIC_RAW)
-  clock_gettime(CLOCK_MONOTONIC_RAW, ts);
-#else
-  clock_gettime(CLOCK_MONOTONIC, ts);
-#endif
+  TraceAt_(ctx, TracingGetTime(), kind, arg1, arg2, arg3);
 }
 
-void Trace_(struct TracingContext *ctx, int kind,
-            EventInt arg1, EventInt arg2, EventInt arg3) {
+void TraceAt_(struct TracingContext *ctx, EventInt time, int kind,
+              EventInt arg1, EventInt arg2, EventInt arg3) {
   if (!ctx)
     return;
 
-  assert(ctx->index < ctx->capacity);
+  if (TracingIsFull(ctx) && !TracingTrySwitch(ctx)) {
+    ctx->dropped++;
+    return;
+  }
 
-  struct Event ev;
-  ev.kind = kind;
-  ev.argptr = ctx->id;
-  TracingGetTimespec(&ev.ts);
-  ev.arg1 = arg1;
-  ev.arg2 = arg2;
-  ev.arg3 = arg3;
+  TracingAppend(ctx, time, kind, arg1, arg2, arg3);
 
-  ctx->buffer[ctx->index++] = ev;
-  if (ctx->index == ctx->capacity)
-    TracingFlushBuffer(ctx);
+  if (TracingIsFull(ctx)) {
+    /* Hand the full buffer off to the writer and keep going in the other one
+     * if it is available. */
+    __atomic_store_n(&ctx->pending[ctx->active], ctx->index, __ATOMIC_RELEASE);
+    pthread_cond_signal(&TracingWriterCond);
+    TracingTrySwitch(ctx);
+  }
 }
@@ -12,34 +12,73 @@
 #include "trace.h"
 
 /* A structure holding the information required to record tracing
- * messages. Messages are buffered into memory and periodically flushed to disk
- * when the buffer is full. */
+ * messages. Messages are encoded in the compact format described in trace.h
+ * and buffered into memory, in one of two buffers. When the active buffer is
+ * full, it is handed off to a dedicated writer thread (shared by all contexts)
+ * and recording continues in the other buffer, so that the thread calling
+ * Trace() never waits for the disk. If the writer has not yet drained the
+ * other buffer, events are dropped and counted instead; the count is recorded
+ * as an EVENT_TRACE_DROPPED event as soon as recording resumes. */
 struct TracingContext {
-  struct Event *buffer;
+  uint8_t *buffers[2];
+  /* Index of the buffer currently being filled. Only touched by the owner. */
+  size_t active;
+  /* Number of bytes handed off to the writer in each buffer, or 0 when the
+   * buffer is free. Set by the owner, cleared by the writer. */
+  size_t pending[2];
   size_t id;
+  /* Fill level and size of each buffer, in bytes. */
   size_t index;
   size_t capacity;
+  /* Timestamp of the last recorded event, in nanoseconds. */
+  EventInt lastTime;
+  /* Number of events dropped since the last EVENT_TRACE_DROPPED. */
+  size_t dropped;
   FILE *file;
+  /* Link in the list of contexts drained by the writer thread. */
+  struct TracingContext *next;
 };
 
-/* Allocates a new tracing context and open its backing file. */
+/* Per-processor state of the sampled tracing mode, used when the runtime is
+ * built without ENABLE_TRACING (see traceSampleRate in gc/controls.h). */
+struct TracingSampleState {
+  /* Scheduler events left to skip before the next one is recorded. */
+  uint32_t skip;
+  /* Bit k is set while a sampled _ENTER of kind k awaits its _LEAVE. */
+  uint64_t open;
+  /* Start of the current LGC and CGC, which are only recorded once they turn
+   * out to be long. */
+  EventInt lgcStart;
+  EventInt cgcStart;
+};
+
+/* Allocates a new tracing context and open its backing file. Each buffer has
+ * room for at least bufferCapacity events. */
 struct TracingContext *TracingNewContext(const char *filename,
                                          size_t bufferCapacity,
                                          uint32_t procNumber);
 
-/* Close a trace file and free the corresponding context. The buffer is
+/* Close a trace file and free the corresponding context. The buffers are
  * flushed. */
 void TracingCloseAndFreeContext(struct TracingContext **ctx);
 
-/* Flush recent events to the backing file. This function is automatically
- * called by Trace() when the trace buffer is full, so there should be no need
- * to call it manually. */
+/* Synchronously write the active buffer to the backing file, after waiting for
+ * the writer thread to finish with any buffer handed off to it. Trace() never
+ * calls this; it is meant for flushing at close. */
 void TracingFlushBuffer(struct TracingContext *ctx);
 
+/* The clock used to timestamp events, in nanoseconds. */
+EventInt TracingNow(void);
+
 /* Add a new log event to the tracing context. */
 void Trace_(struct TracingContext *ctx, int kind,
             EventInt arg1, EventInt arg2, EventInt arg3);
 
+/* Add a new log event that occurred at the given time (from TracingNow), which
+ * should not be earlier than that of the last event added. */
+void TraceAt_(struct TracingContext *ctx, EventInt time, int kind,
+              EventInt arg1, EventInt arg2, EventInt arg3);
+
 #ifdef ENABLE_TRACING
 #define Trace(...) Trace_((s)->trace, __VA_ARGS__)
 #define WITH_GCSTATE(code)                              \